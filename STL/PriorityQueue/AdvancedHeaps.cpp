@@ -0,0 +1,597 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <set>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Heaps Beyond std::priority_queue:
+ *
+ * std::priority_queue is a binary heap with no way to change the priority of an element
+ * that is already inside it. Dijkstra-style schedulers need exactly that, so this file adds:
+ *
+ * 1. **DaryHeap<T, Compare, D>** (default D = 4):
+ *    - Same interface as priority_queue: push, pop, top, empty, size.
+ *    - A 4-ary heap is half as deep as a binary heap and the 4 children of a node sit next to
+ *      each other in memory, so pop touches fewer cache lines.
+ *    - heapify(first, last): replaces the contents with a range in O(n) (bottom-up build).
+ *    - push_range(first, last): bulk insert; rebuilds in O(n) when the batch is large compared
+ *      to the heap, otherwise sifts each new element up.
+ *
+ * 2. **IndexedHeap<T, Compare>**:
+ *    - A 4-ary heap where push() returns a handle that stays valid until the element is popped.
+ *    - decrease_key(handle, value): moves an element towards the top (for a min heap built with
+ *      greater<T> this lowers its key, just like Dijkstra's relax step).
+ *    - update(handle, value): sets any new value and restores the heap in either direction.
+ *
+ * 3. **PairingHeap<T, Compare>**:
+ *    - A heap-ordered multi-way tree; push and decrease_key are O(1), pop is O(log n) amortized.
+ *    - push() returns a node handle used by decrease_key().
+ *
+ * All three take the comparator the same way priority_queue does, so the `customComparator`
+ * lambda from the Lambda Functions example works unchanged:
+ *     auto cmp = [](int a, int b) { return a < b; }; // Max-heap
+ *     DaryHeap<int, decltype(cmp)> heap(cmp);
+ */
+
+// D-ary heap stored in a flat vector; the children of i are D*i+1 .. D*i+D
+template <typename T, typename Compare = less<T>, size_t D = 4>
+class DaryHeap {
+private:
+    vector<T> data;
+    Compare comp; // comp(a, b) == true means a has lower priority than b
+
+    void siftUp(size_t i) {
+        T value = move(data[i]);
+        while (i > 0) {
+            size_t parent = (i - 1) / D;
+            if (!comp(data[parent], value)) break;
+            data[i] = move(data[parent]); // Move the parent down instead of swapping
+            i = parent;
+        }
+        data[i] = move(value);
+    }
+
+    void siftDown(size_t i) {
+        size_t n = data.size();
+        T value = move(data[i]);
+        while (true) {
+            size_t first = D * i + 1;
+            if (first >= n) break;
+            size_t last = first + D < n ? first + D : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (comp(data[best], data[c])) best = c; // Pick the highest priority child
+            }
+            if (!comp(value, data[best])) break;
+            data[i] = move(data[best]);
+            i = best;
+        }
+        data[i] = move(value);
+    }
+
+    // Floyd's bottom-up build: sift down every internal node, last one first
+    void build() {
+        if (data.size() < 2) return;
+        for (size_t i = (data.size() - 2) / D + 1; i-- > 0;) siftDown(i);
+    }
+
+public:
+    explicit DaryHeap(const Compare& c = Compare()) : comp(c) {}
+
+    template <typename Iterator>
+    DaryHeap(Iterator first, Iterator last, const Compare& c = Compare()) : comp(c) {
+        heapify(first, last);
+    }
+
+    // Replace the contents with [first, last) in O(n)
+    template <typename Iterator>
+    void heapify(Iterator first, Iterator last) {
+        data.assign(first, last);
+        build();
+    }
+
+    // Insert [first, last); rebuilding is O(n + m) and wins once m is a fair share of n
+    template <typename Iterator>
+    void push_range(Iterator first, Iterator last) {
+        size_t oldSize = data.size();
+        data.insert(data.end(), first, last);
+        size_t added = data.size() - oldSize;
+        if (added * 8 >= oldSize) {
+            build();
+        } else {
+            for (size_t i = oldSize; i < data.size(); ++i) siftUp(i);
+        }
+    }
+
+    void push(const T& value) {
+        data.push_back(value);
+        siftUp(data.size() - 1);
+    }
+
+    void pop() {
+        data.front() = move(data.back());
+        data.pop_back();
+        if (!data.empty()) siftDown(0);
+    }
+
+    const T& top() const { return data.front(); }
+    bool empty() const { return data.empty(); }
+    size_t size() const { return data.size(); }
+    void reserve(size_t n) { data.reserve(n); }
+};
+
+// 4-ary heap with stable handles so priorities can be changed in place
+template <typename T, typename Compare = less<T>>
+class IndexedHeap {
+public:
+    using Handle = size_t;
+
+private:
+    static constexpr size_t D = 4;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    vector<T> values;        // values[handle]
+    vector<size_t> position; // position[handle] = index in heap, npos once popped
+    vector<Handle> heap;     // heap of handles
+    vector<Handle> freeList; // handles of popped elements, reused by push
+    Compare comp;
+
+    bool less(Handle a, Handle b) const { return comp(values[a], values[b]); }
+
+    void place(size_t i, Handle h) {
+        heap[i] = h;
+        position[h] = i;
+    }
+
+    void siftUp(size_t i) {
+        Handle h = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / D;
+            if (!less(heap[parent], h)) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, h);
+    }
+
+    void siftDown(size_t i) {
+        size_t n = heap.size();
+        Handle h = heap[i];
+        while (true) {
+            size_t first = D * i + 1;
+            if (first >= n) break;
+            size_t last = first + D < n ? first + D : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (less(heap[best], heap[c])) best = c;
+            }
+            if (!less(h, heap[best])) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, h);
+    }
+
+public:
+    explicit IndexedHeap(const Compare& c = Compare()) : comp(c) {}
+
+    Handle push(const T& value) {
+        Handle h;
+        if (!freeList.empty()) {
+            h = freeList.back(); // Reuse a slot from a popped element
+            freeList.pop_back();
+            values[h] = value;
+        } else {
+            h = values.size();
+            values.push_back(value);
+            position.push_back(npos);
+        }
+        heap.push_back(h);
+        siftUp(heap.size() - 1);
+        return h;
+    }
+
+    void pop() {
+        Handle h = heap.front();
+        position[h] = npos;
+        freeList.push_back(h);
+        Handle last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+    }
+
+    // Move an element towards the top; value must not have lower priority than the current one
+    void decrease_key(Handle h, const T& value) {
+        values[h] = value;
+        siftUp(position[h]);
+    }
+
+    // Change an element to any value
+    void update(Handle h, const T& value) {
+        bool up = comp(values[h], value);
+        values[h] = value;
+        if (up) siftUp(position[h]);
+        else siftDown(position[h]);
+    }
+
+    bool contains(Handle h) const { return h < position.size() && position[h] != npos; }
+    const T& get(Handle h) const { return values[h]; }
+    const T& top() const { return values[heap.front()]; }
+    Handle topHandle() const { return heap.front(); }
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+};
+
+// Pairing heap; nodes are linked as leftmost-child / next-sibling with a back pointer
+template <typename T, typename Compare = less<T>>
+class PairingHeap {
+public:
+    struct Node {
+        T value;
+        Node* child;
+        Node* sibling;
+        Node* prev; // Parent if this is the leftmost child, otherwise the previous sibling
+
+        Node(const T& v) : value(v), child(nullptr), sibling(nullptr), prev(nullptr) {}
+    };
+    using Handle = Node*;
+
+private:
+    Node* root;
+    size_t count;
+    Compare comp;
+    vector<Node*> scratch; // Reused by pop() for the two-pass merge
+
+    // Link two root trees, the lower priority one becomes the leftmost child
+    Node* meld(Node* a, Node* b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (comp(a->value, b->value)) swap(a, b);
+        b->prev = a;
+        b->sibling = a->child;
+        if (a->child) a->child->prev = b;
+        a->child = b;
+        a->sibling = nullptr;
+        a->prev = nullptr;
+        return a;
+    }
+
+    // Standard two-pass pairing: meld pairs left to right, then fold right to left
+    Node* mergePairs(Node* first) {
+        scratch.clear();
+        while (first) {
+            Node* a = first;
+            Node* b = a->sibling;
+            first = b ? b->sibling : nullptr;
+            a->sibling = a->prev = nullptr;
+            if (b) b->sibling = b->prev = nullptr;
+            scratch.push_back(meld(a, b));
+        }
+        Node* result = nullptr;
+        for (size_t i = scratch.size(); i-- > 0;) {
+            result = meld(scratch[i], result);
+        }
+        return result;
+    }
+
+    // Unlink a non-root node (and its subtree) from its parent
+    void detach(Node* node) {
+        if (node->prev->child == node) node->prev->child = node->sibling;
+        else node->prev->sibling = node->sibling;
+        if (node->sibling) node->sibling->prev = node->prev;
+        node->sibling = node->prev = nullptr;
+    }
+
+    // Iterative so that deep trees left behind by decrease_key cannot overflow the stack
+    void destroy(Node* node) {
+        vector<Node*> pending;
+        if (node) pending.push_back(node);
+        while (!pending.empty()) {
+            Node* current = pending.back();
+            pending.pop_back();
+            if (current->child) pending.push_back(current->child);
+            if (current->sibling) pending.push_back(current->sibling);
+            delete current;
+        }
+    }
+
+public:
+    explicit PairingHeap(const Compare& c = Compare()) : root(nullptr), count(0), comp(c) {}
+
+    ~PairingHeap() {
+        destroy(root);
+    }
+
+    PairingHeap(const PairingHeap&) = delete;
+    PairingHeap& operator=(const PairingHeap&) = delete;
+
+    Handle push(const T& value) {
+        Node* node = new Node(value);
+        root = meld(root, node);
+        ++count;
+        return node;
+    }
+
+    void pop() {
+        Node* old = root;
+        root = mergePairs(root->child);
+        delete old;
+        --count;
+    }
+
+    // Move an element towards the top; value must not have lower priority than the current one
+    void decrease_key(Handle node, const T& value) {
+        node->value = value;
+        if (node == root) return;
+        detach(node);
+        root = meld(root, node);
+    }
+
+    const T& top() const { return root->value; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+};
+
+// Push/pop benchmark shared by every heap that exposes the priority_queue interface
+template <typename Heap>
+double benchmarkPushPop(Heap& heap, const vector<int>& keys) {
+    auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int k : keys) heap.push(k);
+    while (!heap.empty()) {
+        checksum += heap.top();
+        heap.pop();
+    }
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << ""; // Keep the loop from being optimized away
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Dijkstra-like mix: every pop is followed by a few decrease_key calls on random live entries.
+// Items are (key, id) so the popped id tells us which handles are no longer valid.
+template <typename Heap>
+double benchmarkDecreaseKey(Heap& heap, const vector<int>& keys, int relaxPerPop) {
+    mt19937 rng(7);
+    size_t n = keys.size();
+    vector<typename Heap::Handle> handles(n);
+    vector<int> current(keys);
+    vector<char> alive(n, 1);
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) handles[i] = heap.push({keys[i], static_cast<int>(i)});
+    long long checksum = 0;
+    while (!heap.empty()) {
+        checksum += heap.top().first;
+        alive[heap.top().second] = 0;
+        heap.pop();
+        for (int r = 0; r < relaxPerPop; ++r) {
+            size_t i = rng() % n;
+            if (!alive[i]) continue;
+            current[i] -= 1 + static_cast<int>(rng() % 16);
+            heap.decrease_key(handles[i], {current[i], static_cast<int>(i)});
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << "";
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// The usual priority_queue workaround for decrease_key: push the item again with its new key and
+// skip stale copies (already popped, or carrying an outdated key) when they reach the top.
+double benchmarkLazyDecreaseKey(const vector<int>& keys, int relaxPerPop) {
+    using Item = pair<int, int>;
+    auto byKey = [](const Item& a, const Item& b) { return a.first > b.first; };
+    mt19937 rng(7);
+    size_t n = keys.size();
+    vector<int> current(keys);
+    vector<char> alive(n, 1);
+    auto start = chrono::steady_clock::now();
+    priority_queue<Item, vector<Item>, decltype(byKey)> heap(byKey);
+    for (size_t i = 0; i < n; ++i) heap.push({keys[i], static_cast<int>(i)});
+    long long checksum = 0;
+    while (!heap.empty()) {
+        Item item = heap.top();
+        heap.pop();
+        if (!alive[item.second] || item.first != current[item.second]) continue; // Stale copy
+        checksum += item.first;
+        alive[item.second] = 0;
+        for (int r = 0; r < relaxPerPop; ++r) {
+            size_t i = rng() % n;
+            if (!alive[i]) continue;
+            current[i] -= 1 + static_cast<int>(rng() % 16);
+            heap.push({current[i], static_cast<int>(i)});
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << "";
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Random pushes, pops, decrease_key (and update for IndexedHeap) checked against a set<> of the
+// live (key, id) items: every pop must return the set's first item
+bool heapSelfCheck() {
+    using Item = pair<int, int>;
+    mt19937 rng(26);
+    IndexedHeap<Item, greater<Item>> indexed;
+    PairingHeap<Item, greater<Item>> pairing;
+    set<Item> reference;
+    vector<IndexedHeap<Item, greater<Item>>::Handle> indexedHandles;
+    vector<PairingHeap<Item, greater<Item>>::Handle> pairingHandles;
+    vector<int> current;
+    vector<char> alive;
+
+    auto popAll = [&](bool drain) {
+        do {
+            if (reference.empty()) return indexed.empty() && pairing.empty();
+            Item expected = *reference.begin();
+            if (indexed.top() != expected || pairing.top() != expected) return false;
+            indexed.pop();
+            pairing.pop();
+            reference.erase(reference.begin());
+            alive[expected.second] = 0;
+        } while (drain);
+        return true;
+    };
+
+    for (int step = 0; step < 200000; ++step) {
+        uint32_t op = rng() % 10;
+        if (op < 4) {
+            int id = static_cast<int>(current.size());
+            Item item{static_cast<int>(rng() % 100000), id};
+            indexedHandles.push_back(indexed.push(item));
+            pairingHandles.push_back(pairing.push(item));
+            current.push_back(item.first);
+            alive.push_back(1);
+            reference.insert(item);
+        } else if (op < 8 && !current.empty()) {
+            size_t id = rng() % current.size();
+            if (!alive[id]) continue;
+            reference.erase({current[id], static_cast<int>(id)});
+            bool lower = op < 7; // decrease_key in both heaps, otherwise IndexedHeap::update either way
+            int key = lower ? current[id] - static_cast<int>(rng() % 1000) : static_cast<int>(rng() % 100000);
+            if (lower) {
+                indexed.decrease_key(indexedHandles[id], {key, static_cast<int>(id)});
+                pairing.decrease_key(pairingHandles[id], {key, static_cast<int>(id)});
+            } else {
+                indexed.update(indexedHandles[id], {key, static_cast<int>(id)});
+                // PairingHeap has no increase: emulate update with a decrease to the minimum and a pop
+                pairing.decrease_key(pairingHandles[id], {INT32_MIN, static_cast<int>(id)});
+                pairing.pop();
+                pairingHandles[id] = pairing.push({key, static_cast<int>(id)});
+            }
+            current[id] = key;
+            reference.insert({key, static_cast<int>(id)});
+        } else if (!popAll(false)) {
+            return false;
+        }
+        if (indexed.size() != reference.size() || pairing.size() != reference.size()) return false;
+    }
+    if (!popAll(true)) return false;
+
+    // DaryHeap bulk paths: heapify plus push_range must pop in sorted order
+    vector<int> batch(5000);
+    for (auto& x : batch) x = static_cast<int>(rng() % 1000);
+    DaryHeap<int, greater<int>> dary(batch.begin(), batch.begin() + 1000);
+    dary.push_range(batch.begin() + 1000, batch.begin() + 1100); // Small batch: sift up
+    dary.push_range(batch.begin() + 1100, batch.end());          // Large batch: rebuild
+    sort(batch.begin(), batch.end());
+    for (int x : batch) {
+        if (dary.empty() || dary.top() != x) return false;
+        dary.pop();
+    }
+    return dary.empty();
+}
+
+void heapUsage() {
+    auto customComparator = [](int a, int b) {
+        return a < b; // Max-heap
+    };
+
+    DaryHeap<int, decltype(customComparator)> maxHeap(customComparator);
+    maxHeap.push(10);
+    maxHeap.push(30);
+    maxHeap.push(20);
+    cout << "4-ary Max-Heap elements: ";
+    while (!maxHeap.empty()) {
+        cout << maxHeap.top() << " "; // Output: 30 20 10
+        maxHeap.pop();
+    }
+    cout << endl;
+
+    // Bulk construction in O(n) instead of n pushes
+    vector<int> batch = {7, 3, 9, 1};
+    DaryHeap<int, greater<int>> bulkHeap(batch.begin(), batch.end());
+    bulkHeap.push_range(batch.begin(), batch.begin() + 2); // Adds 7 and 3 again
+    cout << "4-ary Min-Heap built with heapify + push_range: ";
+    while (!bulkHeap.empty()) {
+        cout << bulkHeap.top() << " "; // Output: 1 3 3 7 7 9
+        bulkHeap.pop();
+    }
+    cout << endl;
+
+    // Min heap with handles, as used by Dijkstra
+    IndexedHeap<int, greater<int>> minHeap;
+    auto a = minHeap.push(30);
+    minHeap.push(20);
+    minHeap.push(25);
+    minHeap.decrease_key(a, 5); // 30 -> 5 moves to the top
+    cout << "Indexed Min-Heap after decrease_key(30 -> 5): ";
+    while (!minHeap.empty()) {
+        cout << minHeap.top() << " "; // Output: 5 20 25
+        minHeap.pop();
+    }
+    cout << endl;
+
+    PairingHeap<int, greater<int>> pairing;
+    pairing.push(40);
+    auto b = pairing.push(50);
+    pairing.push(10);
+    pairing.decrease_key(b, 1); // 50 -> 1 moves to the top
+    cout << "Pairing Min-Heap after decrease_key(50 -> 1): ";
+    while (!pairing.empty()) {
+        cout << pairing.top() << " "; // Output: 1 10 40
+        pairing.pop();
+    }
+    cout << endl;
+}
+
+void heapBenchmark() {
+    const size_t n = 1000000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (auto& k : keys) k = static_cast<int>(rng() % 100000000);
+
+    cout << "\nPush/pop of " << n << " random ints (min heap):\n";
+    {
+        priority_queue<int, vector<int>, greater<int>> pq;
+        cout << "  std::priority_queue: " << benchmarkPushPop(pq, keys) << " ms\n";
+    }
+    {
+        DaryHeap<int, greater<int>, 4> heap;
+        cout << "  DaryHeap<4>:         " << benchmarkPushPop(heap, keys) << " ms\n";
+    }
+    {
+        PairingHeap<int, greater<int>> heap;
+        cout << "  PairingHeap:         " << benchmarkPushPop(heap, keys) << " ms\n";
+    }
+    {
+        auto start = chrono::steady_clock::now();
+        DaryHeap<int, greater<int>, 4> heap;
+        heap.heapify(keys.begin(), keys.end());
+        auto end = chrono::steady_clock::now();
+        cout << "  DaryHeap<4>::heapify (build only): "
+             << chrono::duration<double, milli>(end - start).count() << " ms\n";
+    }
+
+    // Same comparator-lambda style as customComparator, ordering (key, id) items as a min heap
+    using Item = pair<int, int>;
+    auto byKey = [](const Item& a, const Item& b) { return a.first > b.first; };
+    const int relaxPerPop = 4;
+    cout << "Push, then pop with " << relaxPerPop << " decrease_key per pop:\n";
+    cout << "  std::priority_queue: " << benchmarkLazyDecreaseKey(keys, relaxPerPop) << " ms (reinsert, skip stale entries on pop)\n";
+    {
+        IndexedHeap<Item, decltype(byKey)> heap(byKey);
+        cout << "  IndexedHeap:         " << benchmarkDecreaseKey(heap, keys, relaxPerPop) << " ms\n";
+    }
+    {
+        PairingHeap<Item, decltype(byKey)> heap(byKey);
+        cout << "  PairingHeap:         " << benchmarkDecreaseKey(heap, keys, relaxPerPop) << " ms\n";
+    }
+}
+
+int main() {
+    heapUsage();
+    cout << "Heap self-check against a sorted reference: " << (heapSelfCheck() ? "passed" : "FAILED") << endl;
+    heapBenchmark();
+    return 0;
+}
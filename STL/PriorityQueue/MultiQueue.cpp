@@ -0,0 +1,295 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * MultiQueue (relaxed concurrent priority queue):
+ *
+ * 1. **Problem**:
+ *    - A single priority_queue behind one mutex serializes every push and pop, so a worker pool
+ *      stops scaling after a handful of threads.
+ *
+ * 2. **Idea**:
+ *    - Keep c * P independent heaps (P = number of threads, c = a small constant like 2-4), each
+ *      with its own lock and padded to its own cache line.
+ *    - push(value): lock a random shard (try another one if it is busy) and push there.
+ *    - pop(): look at the cached tops of two random shards, lock the better one and pop it.
+ *    - Threads rarely meet on the same lock, so throughput grows with the thread count.
+ *
+ * 3. **Relaxed order**:
+ *    - pop() does not always return the global top, but with "best of two" the expected rank of
+ *      the returned element is O(c * P) and does not grow with the queue size.
+ *    - `measureRankError` has P threads pop concurrently, logs every pop and replays the log to
+ *      report the average and worst rank of popped elements.
+ *
+ * 4. **Operations**:
+ *    - push(value), tryPop(value) (false only once every shard is empty), size().
+ *    - T must be trivially copyable, since each shard publishes its top through an atomic<T>
+ *      that pop() reads without the lock. Queue a small struct such as {priority, task index}
+ *      and keep the task itself (std::function, strings, ...) in a side table.
+ */
+
+template <typename T, typename Compare = less<T>>
+class MultiQueue {
+private:
+    // One heap per cache line so that neighbouring locks do not share a line
+    struct alignas(64) Shard {
+        mutex lock;
+        priority_queue<T, vector<T>, Compare> heap;
+        atomic<T> cachedTop;    // Copy of heap.top(), read without the lock
+        atomic<bool> hasTop;
+
+        Shard(const Compare& comp) : heap(comp), cachedTop(T()), hasTop(false) {}
+
+        void refreshTop() {
+            if (heap.empty()) {
+                hasTop.store(false, memory_order_relaxed);
+            } else {
+                cachedTop.store(heap.top(), memory_order_relaxed);
+                hasTop.store(true, memory_order_relaxed);
+            }
+        }
+    };
+
+    static_assert(is_trivially_copyable<T>::value,
+                  "MultiQueue<T>: T must be trivially copyable; queue {priority, task index} instead");
+
+    vector<unique_ptr<Shard>> shards;
+    Compare comp;
+    atomic<long long> count;
+
+    // Cheap per-thread random number generator (xorshift)
+    static size_t randomIndex(size_t n) {
+        thread_local unsigned long long state =
+            0x9E3779B97F4A7C15ULL ^ hash<thread::id>()(this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<size_t>(state % n);
+    }
+
+public:
+    // shardsPerThread is the constant c; threads is P
+    MultiQueue(size_t threads, size_t shardsPerThread = 2, const Compare& c = Compare())
+        : comp(c), count(0) {
+        size_t n = threads * shardsPerThread;
+        if (n < 2) n = 2;
+        for (size_t i = 0; i < n; ++i) shards.emplace_back(new Shard(comp));
+    }
+
+    void push(const T& value) {
+        while (true) {
+            Shard& shard = *shards[randomIndex(shards.size())];
+            if (!shard.lock.try_lock()) continue; // Busy, pick another shard
+            shard.heap.push(value);
+            shard.refreshTop();
+            shard.lock.unlock();
+            count.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    bool tryPop(T& out) {
+        int misses = 0;
+        while (true) {
+            size_t a = randomIndex(shards.size());
+            size_t b = randomIndex(shards.size());
+            bool hasA = shards[a]->hasTop.load(memory_order_relaxed);
+            bool hasB = shards[b]->hasTop.load(memory_order_relaxed);
+            if (!hasA && !hasB) {
+                // Both looked empty; after a few tries fall back to a full scan
+                if (++misses < 8) continue;
+                return popFromAny(out);
+            }
+            // Pick the shard whose cached top has the higher priority
+            size_t best = a;
+            if (!hasA || (hasB && comp(shards[a]->cachedTop.load(memory_order_relaxed),
+                                       shards[b]->cachedTop.load(memory_order_relaxed)))) {
+                best = b;
+            }
+            Shard& shard = *shards[best];
+            if (!shard.lock.try_lock()) continue;
+            if (shard.heap.empty()) { // Emptied by another thread since we looked
+                shard.lock.unlock();
+                continue;
+            }
+            out = shard.heap.top();
+            shard.heap.pop();
+            shard.refreshTop();
+            shard.lock.unlock();
+            count.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Sequential scan used when random probes keep hitting empty shards
+    bool popFromAny(T& out) {
+        for (auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            if (s->heap.empty()) continue;
+            out = s->heap.top();
+            s->heap.pop();
+            s->refreshTop();
+            count.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return static_cast<size_t>(count.load(memory_order_relaxed)); }
+    size_t shardCount() const { return shards.size(); }
+};
+
+// The baseline: one priority_queue behind one mutex
+template <typename T, typename Compare = less<T>>
+class LockedPriorityQueue {
+private:
+    mutex lock;
+    priority_queue<T, vector<T>, Compare> heap;
+
+public:
+    void push(const T& value) {
+        lock_guard<mutex> guard(lock);
+        heap.push(value);
+    }
+
+    bool tryPop(T& out) {
+        lock_guard<mutex> guard(lock);
+        if (heap.empty()) return false;
+        out = heap.top();
+        heap.pop();
+        return true;
+    }
+};
+
+void multiQueueUsage() {
+    // Min queue with 2 shards per thread for 2 threads
+    MultiQueue<int, greater<int>> mq(2);
+    for (int v : {30, 20, 10, 25}) mq.push(v);
+
+    cout << "MultiQueue pops (roughly ascending, order is relaxed):\n";
+    int value;
+    while (mq.tryPop(value)) cout << value << " ";
+    cout << endl;
+}
+
+// Fenwick tree over key values, used to find how many smaller keys are still queued
+class RankCounter {
+private:
+    vector<int> tree;
+
+public:
+    RankCounter(size_t n) : tree(n + 1, 0) {}
+
+    void add(size_t key, int delta) {
+        for (size_t i = key + 1; i < tree.size(); i += i & (0 - i)) tree[i] += delta;
+    }
+
+    // Number of queued keys strictly smaller than key
+    int smaller(size_t key) const {
+        int sum = 0;
+        for (size_t i = key; i > 0; i -= i & (0 - i)) sum += tree[i];
+        return sum;
+    }
+};
+
+// Rank error of a min MultiQueue while `threads` threads pop it concurrently: rank 0 is a perfect
+// pop. Each thread logs its pops with a ticket from a shared counter taken right after the pop;
+// replaying the log in ticket order tells how many smaller keys were still queued at each pop.
+// With fewer cores than threads, a thread descheduled while holding a shard lock hides that
+// shard for a whole time slice, and the ranks grow with the pops made in the meantime.
+void measureRankError(size_t threads, size_t shardsPerThread) {
+    const size_t n = 400000;
+    MultiQueue<int, greater<int>> mq(threads, shardsPerThread);
+    mt19937 rng(1);
+    vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+    shuffle(keys.begin(), keys.end(), rng);
+    for (int k : keys) mq.push(k);
+
+    atomic<uint64_t> ticket(0);
+    vector<vector<pair<uint64_t, int>>> logs(threads);
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            int value;
+            while (mq.tryPop(value)) logs[t].push_back({ticket.fetch_add(1, memory_order_relaxed), value});
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    vector<pair<uint64_t, int>> pops;
+    for (auto& log : logs) pops.insert(pops.end(), log.begin(), log.end());
+    sort(pops.begin(), pops.end());
+    RankCounter queued(n);
+    for (int k : keys) queued.add(k, 1);
+    double total = 0;
+    int worst = 0;
+    for (auto& pop : pops) {
+        int rank = queued.smaller(pop.second);
+        queued.add(pop.second, -1);
+        total += rank;
+        if (rank > worst) worst = rank;
+    }
+    cout << "  P=" << threads << ", c=" << shardsPerThread << " (" << mq.shardCount()
+         << " shards): mean rank " << total / n << ", max rank " << worst
+         << (pops.size() == n ? "" : ", LOST ELEMENTS") << endl;
+}
+
+// Every thread alternates push and pop on a prefilled queue
+template <typename Queue>
+double measureThroughput(Queue& queue, size_t threads, size_t opsPerThread) {
+    for (int i = 0; i < 100000; ++i) queue.push(i);
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue, opsPerThread, t]() {
+            mt19937 rng(static_cast<unsigned>(t));
+            int value = 0;
+            for (size_t i = 0; i < opsPerThread; ++i) {
+                if (i & 1) queue.tryPop(value);
+                else queue.push(static_cast<int>(rng() % 1000000));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+    return threads * opsPerThread / seconds / 1e6; // Million operations per second
+}
+
+void multiQueueBenchmark() {
+    const size_t opsPerThread = 1000000;
+    cout << "\nThroughput (Mops/s), 50% push / 50% pop, hardware threads: "
+         << thread::hardware_concurrency() << endl;
+    for (size_t threads : {1u, 2u, 4u, 8u}) {
+        LockedPriorityQueue<int, greater<int>> locked;
+        MultiQueue<int, greater<int>> mq(threads, 2);
+        double lockedRate = measureThroughput(locked, threads, opsPerThread);
+        double mqRate = measureThroughput(mq, threads, opsPerThread);
+        cout << "  " << threads << " threads: mutex + priority_queue " << lockedRate
+             << ", MultiQueue " << mqRate << endl;
+    }
+
+    cout << "\nRank error with P threads popping (0 = exact priority order):\n";
+    for (size_t threads : {1u, 2u, 4u, 8u}) measureRankError(threads, 2);
+    measureRankError(8, 4);
+}
+
+int main() {
+    multiQueueUsage();
+    multiQueueBenchmark();
+    return 0;
+}
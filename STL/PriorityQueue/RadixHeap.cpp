@@ -0,0 +1,189 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <string>
+
+using namespace std;
+
+/**
+ * Radix Heap (monotone min priority queue for integer keys):
+ *
+ * 1. **Idea**:
+ *    - Keys pushed must never be smaller than the last key popped (event timestamps, Dijkstra
+ *      distances with non-negative weights, ...).
+ *    - Bucket i holds the keys whose highest bit differing from the last popped key is bit i-1
+ *      (bucket 0 holds keys equal to it). Only the bit pattern is used, no comparisons.
+ *    - When bucket 0 runs dry, the first non-empty bucket is scanned for its minimum, that
+ *      minimum becomes the new "last" key and the bucket's keys are redistributed into strictly
+ *      lower buckets. Every key can only move down, at most once per bit.
+ *
+ * 2. **Complexity** (C = largest key minus smallest key in the heap):
+ *    - push(key): O(1).
+ *    - pop(): O(log C) amortized.
+ *
+ * 3. **Operations** (same names as priority_queue, always a min heap):
+ *    - push(key) / push(key, value), pop(), top(), topValue(), empty(), size().
+ *    - Signed key types are accepted; they are mapped to unsigned with the sign bit flipped,
+ *      which keeps their order.
+ */
+
+template <typename Key = int, typename Value = bool>
+class RadixHeap {
+private:
+    using Bits = typename make_unsigned<Key>::type;
+    static constexpr int BITS = numeric_limits<Bits>::digits;
+
+    vector<pair<Bits, Value>> buckets[BITS + 1];
+    Bits last;    // Last popped key (the lower bound for every key in the heap)
+    size_t count;
+
+    // Order preserving conversion from Key to unsigned bits
+    static Bits toBits(Key key) {
+        Bits bits = static_cast<Bits>(key);
+        if (is_signed<Key>::value) bits ^= Bits(1) << (BITS - 1);
+        return bits;
+    }
+
+    static Key fromBits(Bits bits) {
+        if (is_signed<Key>::value) bits ^= Bits(1) << (BITS - 1);
+        return static_cast<Key>(bits);
+    }
+
+    // Index of the bucket for bits: 0 if equal to last, else 1 + highest differing bit
+    int bucketOf(Bits bits) const {
+        Bits diff = bits ^ last;
+        if (diff == 0) return 0;
+        if constexpr (sizeof(Bits) <= sizeof(unsigned int)) return 32 - __builtin_clz(diff);
+        else return 64 - __builtin_clzll(diff);
+    }
+
+    // Refill bucket 0 from the lowest non-empty bucket
+    void pull() {
+        if (!buckets[0].empty()) return;
+        int i = 1;
+        while (buckets[i].empty()) ++i;
+        Bits minimum = buckets[i][0].first;
+        for (const auto& item : buckets[i]) {
+            if (item.first < minimum) minimum = item.first;
+        }
+        last = minimum;
+        for (auto& item : buckets[i]) {
+            buckets[bucketOf(item.first)].push_back(move(item)); // Always a lower bucket
+        }
+        buckets[i].clear();
+    }
+
+public:
+    RadixHeap() : last(0), count(0) {}
+
+    // Key must not be smaller than the last popped key
+    void push(Key key, const Value& value = Value()) {
+        Bits bits = toBits(key);
+        buckets[bucketOf(bits)].emplace_back(bits, value);
+        ++count;
+    }
+
+    void pop() {
+        pull();
+        buckets[0].pop_back();
+        --count;
+    }
+
+    Key top() {
+        pull();
+        return fromBits(last);
+    }
+
+    const Value& topValue() {
+        pull();
+        return buckets[0].back().second;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void clear() {
+        for (auto& bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+};
+
+void radixHeapUsage() {
+    // Same keys as the minHeap demo in main.cpp
+    RadixHeap<int> minHeap;
+    minHeap.push(30);
+    minHeap.push(20);
+    minHeap.push(10);
+    minHeap.push(25);
+
+    cout << "Radix Heap elements:\n";
+    while (!minHeap.empty()) {
+        cout << minHeap.top() << " "; // Output: 10 20 25 30
+        minHeap.pop();
+    }
+    cout << endl;
+
+    // Event queue: timestamps with a payload, new events are never earlier than the current one
+    RadixHeap<unsigned int, string> events;
+    events.push(5, "timeout");
+    events.push(1, "connect");
+    events.push(3, "read");
+    cout << "Events in time order:\n";
+    while (!events.empty()) {
+        unsigned int now = events.top();
+        cout << now << ": " << events.topValue() << endl; // Output: 1 connect, 2 write, 3 read, 5 timeout
+        events.pop();
+        if (now == 1) events.push(now + 1, "write"); // Scheduled from inside the loop
+    }
+}
+
+// Discrete event simulation: keep `live` events, each pop schedules one new event later in time
+template <typename Heap>
+double benchmarkEvents(Heap& heap, size_t live, size_t steps, const vector<int>& deltas) {
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < live; ++i) heap.push(deltas[i % deltas.size()]);
+    long long checksum = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        int now = heap.top();
+        heap.pop();
+        checksum += now;
+        heap.push(now + deltas[i % deltas.size()]);
+    }
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << ""; // Keep the loop from being optimized away
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void radixHeapBenchmark() {
+    mt19937 rng(42);
+    vector<int> deltas(1 << 16);
+    for (auto& d : deltas) d = static_cast<int>(rng() % 1000);
+
+    const size_t steps = 5000000;
+    for (size_t live : {1000u, 100000u, 1000000u}) {
+        cout << "\n" << live << " pending events, " << steps << " pop+push steps:\n";
+        {
+            priority_queue<int, vector<int>, greater<int>> heap;
+            cout << "  priority_queue<int, vector<int>, greater<int>>: "
+                 << benchmarkEvents(heap, live, steps, deltas) << " ms\n";
+        }
+        {
+            RadixHeap<int> heap;
+            cout << "  RadixHeap<int>:                                 "
+                 << benchmarkEvents(heap, live, steps, deltas) << " ms\n";
+        }
+    }
+}
+
+int main() {
+    radixHeapUsage();
+    radixHeapBenchmark();
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include <iostream>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Hierarchical Timer Wheel:
+ *
+ * 1. **Problem**:
+ *    - Timeouts kept in a priority_queue<int, vector<int>, greater<int>> cost O(log n) per schedule,
+ *      and a cancelled timer cannot be removed, so it stays in the heap until its deadline pops
+ *      (lazy deletion). With millions of mostly-cancelled timers the heap is mostly garbage.
+ *
+ * 2. **Idea** (the classic kernel timer wheel):
+ *    - 4 levels of 256 slots. Level 0 slot i holds timers due at a tick whose low byte is i and
+ *      that are less than 256 ticks away; level 1 covers the next 256 * 256 ticks with one slot per
+ *      256 ticks, and so on up to 2^32 ticks.
+ *    - Each slot is an intrusive doubly linked list of timers living in one pooled vector.
+ *    - When the level 0 index wraps to 0, the matching level 1 slot is "cascaded": its timers are
+ *      re-inserted and fall into level 0. Higher levels cascade the same way.
+ *    - Timers further than 2^32 ticks away are parked in the top level and re-inserted when
+ *      their slot cascades.
+ *
+ * 3. **Operations**:
+ *    - schedule(delay, payload): O(1), returns a TimerId.
+ *    - cancel(id): O(1) unlink, safe to call with an id that already fired or was cancelled.
+ *    - tick(onExpire): processes the current tick, calling onExpire(id, payload) for each timer.
+ *    - advance(ticks, onExpire): runs tick() repeatedly.
+ *    - now(), size().
+ */
+
+class TimerWheel {
+public:
+    using TimerId = uint64_t; // Pool index in the low 32 bits, generation in the high 32 bits
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint32_t MASK = SLOTS - 1;
+    static constexpr int32_t NONE = -1;
+
+    struct Timer {
+        uint64_t expiry;
+        uint64_t payload;
+        int32_t prev;
+        int32_t next;
+        uint32_t generation; // Bumped when the node is freed so that stale ids are ignored
+        int16_t slot;        // level * SLOTS + index, -1 when not linked
+    };
+
+    vector<Timer> pool;
+    vector<int32_t> freeList;
+    int32_t heads[LEVELS * SLOTS];
+    uint64_t current; // The next tick to be processed
+    size_t count;
+    bool firing;      // Inside tick(): callbacks run while `current` is still the tick being processed
+
+    void link(int32_t index) {
+        Timer& t = pool[index];
+        uint64_t delta = t.expiry - current;
+        uint64_t due = t.expiry;
+        if (delta > 0xffffffffULL) due = current + 0xffffffffULL; // Park far timers in the top level
+        int level = 0;
+        while (level < LEVELS - 1 && (due - current) >= (1ULL << (SLOT_BITS * (level + 1)))) ++level;
+        int slot = level * SLOTS + static_cast<int>((due >> (SLOT_BITS * level)) & MASK);
+        t.slot = static_cast<int16_t>(slot);
+        t.prev = NONE;
+        t.next = heads[slot];
+        if (t.next != NONE) pool[t.next].prev = index;
+        heads[slot] = index;
+    }
+
+    void unlink(int32_t index) {
+        Timer& t = pool[index];
+        if (t.prev != NONE) pool[t.prev].next = t.next;
+        else heads[t.slot] = t.next;
+        if (t.next != NONE) pool[t.next].prev = t.prev;
+        t.slot = -1;
+    }
+
+    void release(int32_t index) {
+        pool[index].generation++;
+        pool[index].slot = -1;
+        freeList.push_back(index);
+        --count;
+    }
+
+    // Move every timer of a higher level slot down to where it belongs now
+    void cascade(int level) {
+        int slot = level * SLOTS + static_cast<int>((current >> (SLOT_BITS * level)) & MASK);
+        int32_t index = heads[slot];
+        heads[slot] = NONE;
+        while (index != NONE) {
+            int32_t next = pool[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+public:
+    TimerWheel(uint64_t start = 0) : current(start), count(0), firing(false) {
+        for (auto& head : heads) head = NONE;
+    }
+
+    // Fire after `delay` ticks; delay 0 fires on the next tick() call, which from inside a callback
+    // is the tick after the one being processed
+    TimerId schedule(uint64_t delay, uint64_t payload = 0) {
+        int32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<int32_t>(pool.size());
+            pool.push_back(Timer{0, 0, NONE, NONE, 0, -1});
+        }
+        Timer& t = pool[index];
+        t.expiry = current + (firing && delay == 0 ? 1 : delay);
+        t.payload = payload;
+        link(index);
+        ++count;
+        return (static_cast<uint64_t>(t.generation) << 32) | static_cast<uint32_t>(index);
+    }
+
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerId id) {
+        int32_t index = static_cast<int32_t>(id & 0xffffffffULL);
+        uint32_t generation = static_cast<uint32_t>(id >> 32);
+        if (index < 0 || index >= static_cast<int32_t>(pool.size())) return false;
+        Timer& t = pool[index];
+        if (t.generation != generation || t.slot < 0) return false;
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    template <typename Callback>
+    void tick(Callback&& onExpire) {
+        uint32_t index0 = static_cast<uint32_t>(current & MASK);
+        // Cascade upper levels whose lower index just wrapped
+        for (int level = 1; level < LEVELS && index0 == 0; ++level) {
+            cascade(level);
+            if (((current >> (SLOT_BITS * level)) & MASK) != 0) break;
+        }
+        // Pop the due timers one at a time so callbacks may cancel timers of this same tick, and
+        // anything they schedule lands in a later tick
+        firing = true;
+        while (heads[index0] != NONE) {
+            int32_t index = heads[index0];
+            TimerId id = (static_cast<uint64_t>(pool[index].generation) << 32) | static_cast<uint32_t>(index);
+            uint64_t payload = pool[index].payload;
+            unlink(index);
+            release(index);
+            onExpire(id, payload);
+        }
+        firing = false;
+        ++current;
+    }
+
+    template <typename Callback>
+    void advance(uint64_t ticks, Callback&& onExpire) {
+        for (uint64_t i = 0; i < ticks; ++i) tick(onExpire);
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return count; }
+};
+
+void timerWheelUsage() {
+    TimerWheel wheel;
+    wheel.schedule(30, 30); // Payload is the delay so the output is easy to check
+    wheel.schedule(20, 20);
+    auto id = wheel.schedule(10, 10);
+    wheel.schedule(300, 300); // Lands in level 1 and cascades down later
+    wheel.cancel(id);         // The 10 tick timer never fires
+
+    cout << "Timer wheel expirations:\n";
+    wheel.advance(400, [&wheel](TimerWheel::TimerId, uint64_t payload) {
+        cout << "tick " << wheel.now() << ": timer " << payload << endl; // Output: 20, 30, 300
+    });
+    cout << "Pending timers: " << wheel.size() << endl; // Output: 0
+}
+
+// Random schedules and cancels, many of them from inside callbacks, checked against a map of
+// pending timers and their due ticks
+bool timerWheelSelfCheck() {
+    TimerWheel wheel;
+    unordered_map<TimerWheel::TimerId, uint64_t> pending; // id -> tick it must fire on
+    vector<TimerWheel::TimerId> ids;
+    mt19937 rng(30);
+    bool ok = true;
+
+    auto schedule = [&](uint64_t delay, bool inCallback) {
+        TimerWheel::TimerId id = wheel.schedule(delay);
+        ok = ok && !pending.count(id);
+        pending[id] = wheel.now() + (inCallback && delay == 0 ? 1 : delay);
+        ids.push_back(id);
+    };
+    auto cancelRandom = [&]() {
+        if (ids.empty()) return;
+        TimerWheel::TimerId id = ids[rng() % ids.size()];
+        ok = ok && wheel.cancel(id) == (pending.erase(id) == 1);
+    };
+    auto onExpire = [&](TimerWheel::TimerId id, uint64_t) {
+        auto it = pending.find(id);
+        ok = ok && it != pending.end() && it->second == wheel.now();
+        if (it != pending.end()) pending.erase(it);
+        // Timers due on this same tick are the likeliest victims of a cancel from a callback
+        for (auto& [other, due] : pending) {
+            if (due == wheel.now() && rng() % 2) {
+                ok = ok && wheel.cancel(other);
+                pending.erase(other);
+                break;
+            }
+        }
+        if (rng() % 4 == 0) cancelRandom();
+        if (rng() % 2) schedule(rng() % 3 == 0 ? 0 : rng() % 600, true);
+    };
+
+    for (int t = 0; t < 5000 && ok; ++t) {
+        for (int i = rng() % 4; i > 0; --i) schedule(rng() % 3 == 0 ? rng() % 4 : rng() % 70000, false);
+        if (rng() % 3 == 0) cancelRandom();
+        uint64_t processed = wheel.now();
+        wheel.tick(onExpire);
+        for (auto& [id, due] : pending) ok = ok && due > processed;
+        ok = ok && wheel.size() == pending.size();
+    }
+    wheel.advance(70000, onExpire); // Drain, still scheduling from callbacks
+    while (!pending.empty() && ok) wheel.advance(600, [&](TimerWheel::TimerId id, uint64_t) {
+        ok = ok && pending.erase(id) == 1;
+    });
+    return ok && wheel.size() == 0;
+}
+
+// Workload shared by both implementations: every tick schedules `perTick` timeouts, and most of
+// them are cancelled (the request completed) a random number of ticks before they would fire.
+struct TimerWorkload {
+    size_t ticks;
+    size_t perTick;
+    uint64_t timeout;
+    vector<vector<uint32_t>> cancelsAt; // cancelsAt[t] = timers (by creation number) to cancel at tick t
+};
+
+TimerWorkload makeWorkload(size_t ticks, size_t perTick, uint64_t timeout, double cancelRatio) {
+    TimerWorkload w{ticks, perTick, timeout, vector<vector<uint32_t>>(ticks + timeout + 1)};
+    mt19937 rng(3);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    for (size_t t = 0; t < ticks; ++t) {
+        for (size_t i = 0; i < perTick; ++i) {
+            if (coin(rng) < cancelRatio) {
+                uint64_t after = 1 + rng() % (timeout - 1);
+                w.cancelsAt[t + after].push_back(static_cast<uint32_t>(t * perTick + i));
+            }
+        }
+    }
+    return w;
+}
+
+double runWheel(const TimerWorkload& w, size_t& fired) {
+    auto start = chrono::steady_clock::now();
+    TimerWheel wheel;
+    vector<TimerWheel::TimerId> ids(w.ticks * w.perTick);
+    fired = 0;
+    auto onExpire = [&fired](TimerWheel::TimerId, uint64_t) { ++fired; };
+    for (size_t t = 0; t < w.ticks + w.timeout + 1; ++t) {
+        for (uint32_t timer : w.cancelsAt[t]) wheel.cancel(ids[timer]);
+        if (t < w.ticks) {
+            for (size_t i = 0; i < w.perTick; ++i) ids[t * w.perTick + i] = wheel.schedule(w.timeout, t * w.perTick + i);
+        }
+        wheel.tick(onExpire);
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// The minHeap approach: deadlines in a priority_queue, cancellation by marking a flag
+double runHeap(const TimerWorkload& w, size_t& fired, size_t& peakHeap) {
+    auto start = chrono::steady_clock::now();
+    priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>, greater<pair<uint64_t, uint32_t>>> heap;
+    vector<char> cancelled(w.ticks * w.perTick, 0);
+    fired = 0;
+    peakHeap = 0;
+    for (size_t t = 0; t < w.ticks + w.timeout + 1; ++t) {
+        for (uint32_t timer : w.cancelsAt[t]) cancelled[timer] = 1;
+        if (t < w.ticks) {
+            for (size_t i = 0; i < w.perTick; ++i) {
+                heap.push({t + w.timeout, static_cast<uint32_t>(t * w.perTick + i)});
+            }
+        }
+        if (heap.size() > peakHeap) peakHeap = heap.size();
+        while (!heap.empty() && heap.top().first <= t) {
+            if (!cancelled[heap.top().second]) ++fired; // Cancelled entries are only dropped here
+            heap.pop();
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void timerWheelBenchmark() {
+    const size_t ticks = 20000;
+    const size_t perTick = 200;
+    const uint64_t timeout = 5000;
+    for (double cancelRatio : {0.5, 0.95}) {
+        TimerWorkload w = makeWorkload(ticks, perTick, timeout, cancelRatio);
+        size_t firedWheel = 0, firedHeap = 0, peakHeap = 0;
+        double wheelMs = runWheel(w, firedWheel);
+        double heapMs = runHeap(w, firedHeap, peakHeap);
+        cout << "\n" << ticks * perTick << " timers, timeout " << timeout << " ticks, "
+             << cancelRatio * 100 << "% cancelled:\n";
+        cout << "  priority_queue + lazy deletion: " << heapMs << " ms (peak heap size " << peakHeap << ")\n";
+        cout << "  TimerWheel:                     " << wheelMs << " ms\n";
+        cout << "  Fired counts agree: " << (firedWheel == firedHeap ? "Yes" : "No") << endl;
+    }
+}
+
+int main() {
+    timerWheelUsage();
+    bool passed = timerWheelSelfCheck();
+    cout << "Timer wheel self-check: " << (passed ? "passed" : "FAILED") << endl;
+    timerWheelBenchmark();
+    return 0;
+}
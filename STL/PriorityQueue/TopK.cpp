@@ -0,0 +1,208 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Streaming Top-K Selection:
+ *
+ * 1. **Problem**:
+ *    - Pushing a whole stream into a priority_queue and popping k times costs O(n) memory and
+ *      O(n log n) time, even though only k elements are ever needed.
+ *
+ * 2. **TopK<T, Compare>**:
+ *    - Keeps the k best elements seen so far ("best" means what
+ *      priority_queue<T, vector<T>, Compare> would return from top(): the largest with less<T>,
+ *      the smallest with greater<T>).
+ *    - Internally a fixed-size heap whose top is the weakest kept element, the threshold. A new
+ *      element only enters if it beats the threshold, so memory stays O(k).
+ *    - offer(value): O(1) when rejected, O(log k) when accepted.
+ *    - offer(first, last): batch version. On contiguous int data (pointers or vector iterators)
+ *      with less/greater it compares 16 values at a time against the threshold with SSE2 and
+ *      skips whole blocks that cannot enter. After the first few thousand elements almost every
+ *      block is skipped, so the scan runs at memory speed.
+ *    - sorted(): the kept elements, best first.
+ *
+ * 3. **Bulk heap construction** lives next to the heaps in AdvancedHeaps.cpp:
+ *    DaryHeap::heapify(first, last) and DaryHeap::push_range(first, last).
+ */
+
+template <typename T, typename Compare = less<T>>
+class TopK {
+private:
+    size_t k;
+    vector<T> heap; // std heap ordered so that front() is the weakest kept element
+    Compare comp;
+
+    // Heap comparator: a comes after b when a is better, which puts the weakest on top
+    struct Weaker {
+        Compare comp;
+        bool operator()(const T& a, const T& b) const { return comp(b, a); }
+    };
+
+    static constexpr bool simdLess = is_same<T, int>::value && is_same<Compare, less<int>>::value;
+    static constexpr bool simdGreater = is_same<T, int>::value && is_same<Compare, greater<int>>::value;
+
+    // Iterators known to walk contiguous memory (C++17 has no contiguous_iterator concept)
+    template <typename Iterator>
+    static constexpr bool contiguous = is_convertible<Iterator, const T*>::value ||
+                                       is_same<Iterator, typename vector<T>::iterator>::value ||
+                                       is_same<Iterator, typename vector<T>::const_iterator>::value;
+
+#ifdef __SSE2__
+    // Bit mask of the values in block[0..16) that beat the threshold
+    static int candidates(const int* block, int threshold) {
+        __m128i t = _mm_set1_epi32(threshold);
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 4));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 8));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 12));
+        if (simdLess) {
+            a = _mm_cmpgt_epi32(a, t);
+            b = _mm_cmpgt_epi32(b, t);
+            c = _mm_cmpgt_epi32(c, t);
+            d = _mm_cmpgt_epi32(d, t);
+        } else {
+            a = _mm_cmplt_epi32(a, t);
+            b = _mm_cmplt_epi32(b, t);
+            c = _mm_cmplt_epi32(c, t);
+            d = _mm_cmplt_epi32(d, t);
+        }
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        return _mm_movemask_epi8(any);
+    }
+#endif
+
+public:
+    explicit TopK(size_t k, const Compare& c = Compare()) : k(k), comp(c) {
+        heap.reserve(k);
+    }
+
+    void offer(const T& value) {
+        if (heap.size() < k) {
+            heap.push_back(value);
+            push_heap(heap.begin(), heap.end(), Weaker{comp});
+        } else if (k > 0 && comp(heap.front(), value)) {
+            // Replace the weakest element and restore the heap
+            pop_heap(heap.begin(), heap.end(), Weaker{comp});
+            heap.back() = value;
+            push_heap(heap.begin(), heap.end(), Weaker{comp});
+        }
+    }
+
+    template <typename Iterator>
+    void offer(Iterator first, Iterator last) {
+        if constexpr (contiguous<Iterator>) {
+            if (first != last) offerContiguous(&*first, &*first + (last - first));
+        } else {
+            for (; first != last; ++first) offer(*first);
+        }
+    }
+
+    // Batch offer over contiguous memory, the path that can use SIMD pre-filtering
+    void offerContiguous(const T* first, const T* last) {
+        // Fill the heap first; the threshold only exists once k elements are kept
+        while (first != last && heap.size() < k) offer(*first++);
+#ifdef __SSE2__
+        if constexpr (simdLess || simdGreater) {
+            if (k > 0) {
+                while (last - first >= 16) {
+                    if (candidates(first, heap.front()) != 0) {
+                        for (int i = 0; i < 16; ++i) offer(first[i]);
+                    }
+                    first += 16;
+                }
+            }
+        }
+#endif
+        while (first != last) offer(*first++);
+    }
+
+    // Kept elements, best first
+    vector<T> sorted() const {
+        vector<T> result(heap);
+        sort(result.begin(), result.end(), [this](const T& a, const T& b) { return comp(b, a); });
+        return result;
+    }
+
+    // The weakest kept element, the bar a new element has to beat
+    const T& threshold() const { return heap.front(); }
+    size_t size() const { return heap.size(); }
+    void clear() { heap.clear(); }
+};
+
+void topKUsage() {
+    vector<int> stream = {30, 20, 10, 25, 5, 40, 15};
+
+    TopK<int> largest(3);
+    largest.offer(stream.begin(), stream.end());
+    cout << "Top 3 largest: ";
+    for (int n : largest.sorted()) cout << n << " "; // Output: 40 30 25
+    cout << endl;
+
+    TopK<int, greater<int>> smallest(3);
+    for (int n : stream) smallest.offer(n);
+    cout << "Top 3 smallest: ";
+    for (int n : smallest.sorted()) cout << n << " "; // Output: 5 10 15
+    cout << endl;
+}
+
+void topKBenchmark() {
+    const size_t n = 50000000;
+    const size_t k = 1000;
+    mt19937 rng(42);
+    vector<int> data(n);
+    for (auto& x : data) x = static_cast<int>(rng() & 0x7fffffff);
+
+    cout << "\nTop " << k << " of " << n << " ints:\n";
+    long long checksum[3] = {0, 0, 0};
+    {
+        // The priorityQueueUsage pattern: push everything, pop k times
+        auto start = chrono::steady_clock::now();
+        priority_queue<int> pq;
+        for (int x : data) pq.push(x);
+        for (size_t i = 0; i < k; ++i) {
+            checksum[0] += pq.top();
+            pq.pop();
+        }
+        auto end = chrono::steady_clock::now();
+        cout << "  priority_queue push all + pop k: "
+             << chrono::duration<double, milli>(end - start).count() << " ms\n";
+    }
+    {
+        auto start = chrono::steady_clock::now();
+        TopK<int> top(k);
+        for (int x : data) top.offer(x); // Scalar path
+        for (int x : top.sorted()) checksum[1] += x;
+        auto end = chrono::steady_clock::now();
+        cout << "  TopK::offer per element:         "
+             << chrono::duration<double, milli>(end - start).count() << " ms\n";
+    }
+    {
+        auto start = chrono::steady_clock::now();
+        TopK<int> top(k);
+        top.offer(data.begin(), data.end()); // SIMD pre-filtered batch
+        for (int x : top.sorted()) checksum[2] += x;
+        auto end = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+        cout << "  TopK::offer batch:               " << ms << " ms ("
+             << n * sizeof(int) / ms / 1e6 << " GB/s)\n";
+    }
+    cout << "  Results agree: " << (checksum[0] == checksum[1] && checksum[1] == checksum[2] ? "Yes" : "No")
+         << endl;
+}
+
+int main() {
+    topKUsage();
+    topKBenchmark();
+    return 0;
+}
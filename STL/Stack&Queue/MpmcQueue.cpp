@@ -0,0 +1,358 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Bounded Multi-Producer / Multi-Consumer Queue (Vyukov style):
+ *
+ * 1. **Problem**:
+ *    - Many producers and many consumers sharing one queue<int> behind a mutex all serialize on
+ *      that one lock.
+ *
+ * 2. **MpmcQueue<T>**:
+ *    - A ring of cells, each with its own sequence number. For cell i on lap L:
+ *        sequence == pos       -> free, a producer at position pos may claim it
+ *        sequence == pos + 1   -> full, a consumer at position pos may claim it
+ *    - Producers claim positions with a CAS on `enqueuePos`, consumers on `dequeuePos`; the two
+ *      counters live on different cache lines so producers and consumers do not contend.
+ *    - After writing (reading) the value the thread publishes the cell by storing the next
+ *      sequence number with release order. No lock, and no ABA since positions only grow.
+ *
+ * 3. **Operations**:
+ *    - try_push(value) / try_pop(value): never block, return false when full / empty.
+ *    - push(value) / pop(): block until there is room / data. They spin briefly, then sleep.
+ *      With futex waiting enabled (Linux only, the default there) sleepers park in the kernel on
+ *      a 32-bit "epoch" word and are woken only when some thread is actually waiting; otherwise
+ *      they fall back to yielding.
+ *    - size_approx(), capacity().
+ */
+
+template <typename T>
+class MpmcQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Cell {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    // Futex parking spot: epoch is bumped whenever a sleeping waiter has to be woken
+    struct alignas(CACHE_LINE) WaitWord {
+        atomic<uint32_t> epoch{0};
+        atomic<uint32_t> waiters{0};
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    bool useFutex;
+
+    alignas(CACHE_LINE) atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) atomic<size_t> dequeuePos;
+
+    WaitWord notEmpty; // Consumers wait here
+    WaitWord notFull;  // Producers wait here
+
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    void sleepOn(WaitWord& word, uint32_t seen) {
+#ifdef __linux__
+        if (useFutex) {
+            // Returns immediately if epoch already moved past `seen`
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word.epoch), FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0);
+            return;
+        }
+#endif
+        (void)word;
+        (void)seen;
+        this_thread::yield();
+    }
+
+    // The fence pairs with the waiter's seq_cst increment: either we see the waiter, or the
+    // waiter's re-check sees the cell we just published
+    void signal(WaitWord& word) {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (word.waiters.load(memory_order_relaxed) == 0) return; // Nobody sleeping, no syscall
+        word.epoch.fetch_add(1, memory_order_release);
+#ifdef __linux__
+        if (useFutex) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word.epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+#endif
+    }
+
+    // Shared blocking loop: spin on attempt(), yield a few times, then register as a waiter and sleep
+    template <typename Attempt>
+    void waitUntil(WaitWord& word, Attempt attempt) {
+        for (int spin = 0; spin < 64; ++spin) {
+            if (attempt()) return;
+        }
+        for (int spin = 0; spin < 16; ++spin) {
+            this_thread::yield();
+            if (attempt()) return;
+        }
+        while (true) {
+            word.waiters.fetch_add(1, memory_order_seq_cst);
+            uint32_t seen = word.epoch.load(memory_order_acquire);
+            if (attempt()) { // Re-check after registering so a wake-up cannot be missed
+                word.waiters.fetch_sub(1, memory_order_relaxed);
+                return;
+            }
+            sleepOn(word, seen);
+            word.waiters.fetch_sub(1, memory_order_relaxed);
+            if (attempt()) return;
+        }
+    }
+
+public:
+#ifdef __linux__
+    explicit MpmcQueue(size_t capacity, bool futexWaiting = true)
+#else
+    explicit MpmcQueue(size_t capacity, bool futexWaiting = false)
+#endif
+        : cells(new Cell[roundUp(capacity)]), mask(roundUp(capacity) - 1), useFutex(futexWaiting),
+          enqueuePos(0), dequeuePos(0) {
+        for (size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool try_push(const T& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    signal(notEmpty);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Cell still holds last lap's value: full
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed); // Another producer got it
+            }
+        }
+    }
+
+    bool try_pop(T& out) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    out = move(cell.value);
+                    cell.sequence.store(pos + mask + 1, memory_order_release); // Free for next lap
+                    signal(notFull);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Not written yet: empty
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(const T& value) {
+        waitUntil(notFull, [&]() { return try_push(value); });
+    }
+
+    T pop() {
+        T value;
+        waitUntil(notEmpty, [&]() { return try_pop(value); });
+        return value;
+    }
+
+    size_t size_approx() const {
+        size_t tail = enqueuePos.load(memory_order_relaxed);
+        size_t head = dequeuePos.load(memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return mask + 1; }
+};
+
+// Baseline: queue<int> with one mutex and two condition variables
+template <typename T>
+class LockedBoundedQueue {
+private:
+    mutex lock;
+    condition_variable notEmpty, notFull;
+    queue<T> q;
+    size_t limit;
+
+public:
+    explicit LockedBoundedQueue(size_t capacity) : limit(capacity) {}
+
+    void push(const T& value) {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [this]() { return q.size() < limit; });
+        q.push(value);
+        notEmpty.notify_one();
+    }
+
+    T pop() {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this]() { return !q.empty(); });
+        T value = q.front();
+        q.pop();
+        notFull.notify_one();
+        return value;
+    }
+};
+
+void mpmcUsage() {
+    MpmcQueue<int> q(4);
+    q.try_push(10);
+    q.try_push(20);
+    int value = 0;
+    q.try_pop(value);
+    cout << "Popped: " << value << endl; // Output: 10
+
+    // Two producers, two consumers
+    MpmcQueue<int> work(256);
+    atomic<long long> sum(0);
+    vector<thread> threads;
+    for (int p = 0; p < 2; ++p) {
+        threads.emplace_back([&work, p]() {
+            for (int i = 1; i <= 500; ++i) work.push(p * 500 + i);
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&work, &sum]() {
+            for (int i = 0; i < 500; ++i) sum += work.pop();
+        });
+    }
+    for (auto& t : threads) t.join();
+    cout << "Sum received by consumers: " << sum << endl; // Output: 500500
+}
+
+// Three producers and three consumers through a 4-slot queue: it wraps constantly, and pauses
+// on either side force the other side into the blocking (futex or yield) path. Every item must
+// arrive exactly once, and each consumer must see each producer's items in the order pushed.
+bool mpmcSelfCheck(bool futexWaiting) {
+    const int producers = 3, consumers = 3;
+    const uint32_t perProducer = 200000;
+    const uint32_t perConsumer = producers * perProducer / consumers;
+    MpmcQueue<uint64_t> q(4, futexWaiting);
+    vector<vector<uint64_t>> received(consumers);
+    vector<thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&q, p]() {
+            mt19937 rng(p);
+            this_thread::sleep_for(chrono::milliseconds(20)); // Consumers start on an empty queue
+            for (uint32_t i = 0; i < perProducer; ++i) {
+                uint64_t item = (uint64_t(p) << 32) | i;
+                if (rng() % 2) q.push(item);
+                else while (!q.try_push(item)) this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&q, &received, c]() {
+            mt19937 rng(100 + c);
+            received[c].reserve(perConsumer);
+            for (uint32_t i = 0; i < perConsumer; ++i) {
+                if (i == perConsumer / 2) this_thread::sleep_for(chrono::milliseconds(20)); // Producers fill up
+                uint64_t item;
+                if (rng() % 2) item = q.pop();
+                else while (!q.try_pop(item)) this_thread::yield();
+                received[c].push_back(item);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    vector<vector<char>> seen(producers, vector<char>(perProducer, 0));
+    for (auto& items : received) {
+        vector<int64_t> last(producers, -1);
+        for (uint64_t item : items) {
+            uint32_t p = static_cast<uint32_t>(item >> 32), i = static_cast<uint32_t>(item);
+            if (p >= static_cast<uint32_t>(producers) || i >= perProducer || seen[p][i]) return false; // Corrupt or duplicate
+            if (static_cast<int64_t>(i) <= last[p]) return false; // Out of order for this producer
+            seen[p][i] = 1;
+            last[p] = i;
+        }
+    }
+    return q.size_approx() == 0; // perConsumer * consumers items popped, all distinct: none lost
+}
+
+// Split `items` across producers and consumers; returns million items per second
+template <typename Queue>
+double runMatrixCell(Queue& q, int producers, int consumers, size_t items) {
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    atomic<long long> sum(0);
+    for (int p = 0; p < producers; ++p) {
+        size_t share = items / producers + (p < static_cast<int>(items % producers) ? 1 : 0);
+        threads.emplace_back([&q, share]() {
+            for (size_t i = 0; i < share; ++i) q.push(static_cast<int>(i));
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        size_t share = items / consumers + (c < static_cast<int>(items % consumers) ? 1 : 0);
+        threads.emplace_back([&q, &sum, share]() {
+            long long local = 0;
+            for (size_t i = 0; i < share; ++i) local += q.pop();
+            sum += local;
+        });
+    }
+    for (auto& t : threads) t.join();
+    auto end = chrono::steady_clock::now();
+    return items / chrono::duration<double>(end - start).count() / 1e6;
+}
+
+void mpmcBenchmark() {
+    const size_t items = 2000000;
+    const size_t capacity = 1024;
+    cout << "\nM items/s for " << items << " items, capacity " << capacity
+         << " (mutex+cv / MpmcQueue yield / MpmcQueue futex):\n";
+    for (int producers : {1, 2, 4}) {
+        for (int consumers : {1, 2, 4}) {
+            LockedBoundedQueue<int> locked(capacity);
+            MpmcQueue<int> spinning(capacity, false);
+            MpmcQueue<int> futex(capacity, true);
+            double a = runMatrixCell(locked, producers, consumers, items);
+            double b = runMatrixCell(spinning, producers, consumers, items);
+            double c = runMatrixCell(futex, producers, consumers, items);
+            cout << "  " << producers << "P x " << consumers << "C: " << a << " / " << b << " / " << c << endl;
+        }
+    }
+}
+
+int main() {
+    mpmcUsage();
+    bool passed = mpmcSelfCheck(false);
+#ifdef __linux__
+    passed = passed && mpmcSelfCheck(true);
+#endif
+    cout << "MPMC self-check (3P x 3C, wraparound, blocking paths): " << (passed ? "passed" : "FAILED") << endl;
+    mpmcBenchmark();
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <stack>
+#include <vector>
+#include <deque>
+#include <string>
+#include <chrono>
+#include <new>
+#include <utility>
+#include <cstdlib>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Small Stacks Without the Allocator:
+ *
+ * 1. **Problem**:
+ *    - stack<int> defaults to deque<int>, which allocates a 512-byte block (plus its map) as soon
+ *      as the first element is pushed. A parser that builds millions of stacks holding a
+ *      handful of elements spends its time in malloc/free.
+ *
+ * 2. **SmallStack<T, N>**:
+ *    - The first N elements live inside the object itself (no allocation at all).
+ *    - Pushing element N+1 moves everything to a heap buffer which then grows by doubling, so deep
+ *      stacks still work.
+ *    - Same interface as stack: push, emplace, pop, top, empty, size.
+ *
+ * 3. **FixedStack<T, N>**:
+ *    - Never allocates; capacity is exactly N.
+ *    - push / emplace return false instead of growing when the stack is full.
+ *
+ * Elements are constructed and destroyed in place, so non-trivial types like string work too.
+ */
+
+template <typename T, size_t N>
+class SmallStack {
+private:
+    alignas(T) unsigned char inlineStorage[N * sizeof(T)];
+    T* data;         // Points at inlineStorage until the first spill
+    size_t count;
+    size_t capacity;
+
+    bool isInline() const { return data == reinterpret_cast<const T*>(inlineStorage); }
+
+    // Builds the new element in the bigger buffer before moving the old ones, so arguments that
+    // refer into the stack (s.push(s.top())) are still alive when they are read
+    template <typename... Args>
+    void growAndEmplace(Args&&... args) {
+        size_t newCapacity = capacity * 2;
+        T* bigger = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        try {
+            new (bigger + count) T(forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(bigger);
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            new (bigger + i) T(move(data[i])); // Move into the new buffer
+            data[i].~T();
+        }
+        if (!isInline()) ::operator delete(data);
+        data = bigger;
+        capacity = newCapacity;
+    }
+
+public:
+    SmallStack() : data(reinterpret_cast<T*>(inlineStorage)), count(0), capacity(N) {
+        static_assert(N > 0, "SmallStack needs at least one inline slot");
+    }
+
+    ~SmallStack() {
+        clear();
+        if (!isInline()) ::operator delete(data);
+    }
+
+    SmallStack(const SmallStack& other) : SmallStack() {
+        for (size_t i = 0; i < other.count; ++i) push(other.data[i]);
+    }
+
+    SmallStack& operator=(const SmallStack& other) {
+        if (this != &other) {
+            clear();
+            for (size_t i = 0; i < other.count; ++i) push(other.data[i]);
+        }
+        return *this;
+    }
+
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (count == capacity) growAndEmplace(forward<Args>(args)...);
+        else new (data + count) T(forward<Args>(args)...);
+        ++count;
+    }
+
+    void pop() {
+        data[--count].~T();
+    }
+
+    T& top() { return data[count - 1]; }
+    const T& top() const { return data[count - 1]; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    bool spilled() const { return !isInline(); } // True once the stack moved to the heap
+
+    void clear() {
+        while (count > 0) pop();
+    }
+};
+
+template <typename T, size_t N>
+class FixedStack {
+private:
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    size_t count;
+
+    T* data() { return reinterpret_cast<T*>(storage); }
+    const T* data() const { return reinterpret_cast<const T*>(storage); }
+
+public:
+    FixedStack() : count(0) {}
+
+    ~FixedStack() {
+        clear();
+    }
+
+    FixedStack(const FixedStack& other) : count(0) {
+        for (size_t i = 0; i < other.count; ++i) push(other.data()[i]);
+    }
+
+    FixedStack& operator=(const FixedStack& other) {
+        if (this != &other) {
+            clear();
+            for (size_t i = 0; i < other.count; ++i) push(other.data()[i]);
+        }
+        return *this;
+    }
+
+    // Returns false if the stack is full
+    bool push(const T& value) {
+        return emplace(value);
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        if (count == N) return false;
+        new (data() + count) T(forward<Args>(args)...);
+        ++count;
+        return true;
+    }
+
+    void pop() {
+        data()[--count].~T();
+    }
+
+    T& top() { return data()[count - 1]; }
+    const T& top() const { return data()[count - 1]; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+    size_t size() const { return count; }
+    static constexpr size_t capacity() { return N; }
+
+    void clear() {
+        while (count > 0) pop();
+    }
+};
+
+void smallStackUsage() {
+    SmallStack<int, 4> s; // Same steps as stackUsage()
+    s.push(10);
+    s.push(20);
+    s.push(30);
+    cout << "Stack after pushes: " << s.top() << endl; // Output: 30
+    s.pop();
+    cout << "Stack after popping: " << s.top() << endl; // Output: 20
+    cout << "Is stack empty? " << (s.empty() ? "Yes" : "No") << endl; // Output: No
+    cout << "Size of stack: " << s.size() << endl; // Output: 2
+
+    for (int i = 0; i < 10; ++i) s.push(i);
+    cout << "Spilled to heap after 12 elements? " << (s.spilled() ? "Yes" : "No") << endl; // Output: Yes
+
+    FixedStack<string, 2> names;
+    names.push("Alice");
+    names.push("Bob");
+    cout << "Push onto full FixedStack succeeded? " << (names.push("Charlie") ? "Yes" : "No") << endl; // Output: No
+    cout << "FixedStack top: " << names.top() << endl; // Output: Bob
+}
+
+// Parser-like workload: many short-lived stacks, each holding a few elements
+template <typename Stack>
+double benchmarkTinyStacks(size_t stacks, int depth) {
+    auto start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (size_t i = 0; i < stacks; ++i) {
+        Stack s;
+        for (int d = 0; d < depth; ++d) s.push(static_cast<int>(i) + d);
+        while (!s.empty()) {
+            checksum += s.top();
+            s.pop();
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << ""; // Keep the loop from being optimized away
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void smallStackBenchmark() {
+    const size_t stacks = 5000000;
+    for (int depth : {4, 12, 40}) {
+        cout << "\n" << stacks << " stacks, " << depth << " pushes + pops each:\n";
+        cout << "  stack<int> (deque):          " << benchmarkTinyStacks<stack<int>>(stacks, depth) << " ms\n";
+        cout << "  stack<int, vector<int>>:     " << benchmarkTinyStacks<stack<int, vector<int>>>(stacks, depth) << " ms\n";
+        cout << "  SmallStack<int, 16>:         " << benchmarkTinyStacks<SmallStack<int, 16>>(stacks, depth) << " ms\n";
+        cout << "  FixedStack<int, 64>:         " << benchmarkTinyStacks<FixedStack<int, 64>>(stacks, depth) << " ms\n";
+    }
+}
+
+int main() {
+    smallStackUsage();
+    smallStackBenchmark();
+    return 0;
+}
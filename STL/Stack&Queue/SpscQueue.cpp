@@ -0,0 +1,328 @@
+#include <iostream>
+#include <queue>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Lock-free Single-Producer / Single-Consumer Ring Buffer:
+ *
+ * 1. **Problem**:
+ *    - A queue<int> (over deque) shared by a reader thread and a worker thread needs a mutex, so
+ *      every push and pop pays for a lock round trip and the two threads fight over it.
+ *
+ * 2. **SpscQueue<T>**:
+ *    - Bounded ring buffer, capacity rounded up to a power of two so wrapping is a bit mask.
+ *    - Only the producer writes `tail` and only the consumer writes `head`; each is published with
+ *      a release store and read with an acquire load, so no lock or read-modify-write is needed.
+ *    - head and tail sit on separate cache lines, and each side keeps a private cached copy of
+ *      the other side's index, refreshed only when the queue looks full (or empty). Most
+ *      operations therefore touch no shared cache line at all.
+ *
+ * 3. **Operations** (push side from one thread, pop side from one other thread):
+ *    - try_push(value) / try_pop(value): return false when full / empty.
+ *    - push(value) / pop(): spin (yielding) until there is room / data.
+ *    - push_n(values, n) / pop_n(out, n): move up to n elements with one index update.
+ *    - size_approx(), capacity().
+ */
+
+template <typename T>
+class SpscQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    vector<T> buffer;
+    size_t mask;
+
+    // Consumer side
+    alignas(CACHE_LINE) atomic<size_t> head;
+    size_t cachedTail; // Consumer's last view of tail
+
+    // Producer side
+    alignas(CACHE_LINE) atomic<size_t> tail;
+    size_t cachedHead; // Producer's last view of head
+
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : buffer(roundUp(capacity)), mask(roundUp(capacity) - 1), head(0), cachedTail(0), tail(0), cachedHead(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool try_push(const T& value) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - cachedHead == buffer.size()) {
+            cachedHead = head.load(memory_order_acquire); // Looks full, refresh
+            if (t - cachedHead == buffer.size()) return false;
+        }
+        buffer[t & mask] = value;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire); // Looks empty, refresh
+            if (h == cachedTail) return false;
+        }
+        out = move(buffer[h & mask]);
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    void push(const T& value) {
+        while (!try_push(value)) this_thread::yield();
+    }
+
+    T pop() {
+        T value;
+        while (!try_pop(value)) this_thread::yield();
+        return value;
+    }
+
+    // Push up to n values, returns how many were pushed
+    size_t push_n(const T* values, size_t n) {
+        size_t t = tail.load(memory_order_relaxed);
+        size_t room = buffer.size() - (t - cachedHead);
+        if (room < n) {
+            cachedHead = head.load(memory_order_acquire);
+            room = buffer.size() - (t - cachedHead);
+        }
+        if (n > room) n = room;
+        for (size_t i = 0; i < n; ++i) buffer[(t + i) & mask] = values[i];
+        tail.store(t + n, memory_order_release); // One publish for the whole batch
+        return n;
+    }
+
+    // Pop up to n values into out, returns how many were popped
+    size_t pop_n(T* out, size_t n) {
+        size_t h = head.load(memory_order_relaxed);
+        size_t available = cachedTail - h;
+        if (available < n) {
+            cachedTail = tail.load(memory_order_acquire);
+            available = cachedTail - h;
+        }
+        if (n > available) n = available;
+        for (size_t i = 0; i < n; ++i) out[i] = move(buffer[(h + i) & mask]);
+        head.store(h + n, memory_order_release);
+        return n;
+    }
+
+    size_t size_approx() const {
+        return tail.load(memory_order_acquire) - head.load(memory_order_acquire);
+    }
+
+    size_t capacity() const { return buffer.size(); }
+};
+
+// The queueUsage() pattern shared between threads: queue<int> behind a mutex
+template <typename T>
+class LockedQueue {
+private:
+    mutex lock;
+    queue<T> q;
+
+public:
+    void push(const T& value) {
+        lock_guard<mutex> guard(lock);
+        q.push(value);
+    }
+
+    bool try_pop(T& out) {
+        lock_guard<mutex> guard(lock);
+        if (q.empty()) return false;
+        out = q.front();
+        q.pop();
+        return true;
+    }
+
+    T pop() {
+        T value;
+        while (!try_pop(value)) this_thread::yield();
+        return value;
+    }
+};
+
+void spscUsage() {
+    SpscQueue<int> q(4); // Capacity 4
+    q.try_push(10);
+    q.try_push(20);
+    q.try_push(30);
+    int value = 0;
+    q.try_pop(value);
+    cout << "Popped: " << value << endl; // Output: 10
+
+    int batch[] = {40, 50, 60};
+    cout << "push_n pushed: " << q.push_n(batch, 3) << endl; // Output: 2 (queue is full after 40, 50)
+
+    int out[8];
+    size_t n = q.pop_n(out, 8);
+    cout << "pop_n popped: ";
+    for (size_t i = 0; i < n; ++i) cout << out[i] << " "; // Output: 20 30 40 50
+    cout << endl;
+
+    // One producer thread, one consumer thread
+    SpscQueue<int> channel(1024);
+    long long sum = 0;
+    thread consumer([&channel, &sum]() {
+        for (int i = 0; i < 1000; ++i) sum += channel.pop();
+    });
+    for (int i = 1; i <= 1000; ++i) channel.push(i);
+    consumer.join();
+    cout << "Sum received by consumer: " << sum << endl; // Output: 500500
+}
+
+// A producer sends 0, 1, 2, ... through a tiny queue (many wraparounds, constantly full or empty)
+// mixing every push flavour; the consumer mixes every pop flavour and must see each value once,
+// in order
+bool spscSelfCheck() {
+    const uint64_t n = 2000000;
+    SpscQueue<uint64_t> q(8);
+    bool ok = true;
+    thread consumer([&q, &ok, n]() {
+        mt19937 rng(2);
+        uint64_t expected = 0, out[13];
+        while (expected < n) {
+            uint32_t op = rng() % 3;
+            if (op == 0) {
+                uint64_t value;
+                if (q.try_pop(value)) ok = ok && value == expected++;
+                else this_thread::yield();
+            } else if (op == 1) {
+                ok = ok && q.pop() == expected++;
+            } else {
+                size_t got = q.pop_n(out, 1 + rng() % 13);
+                if (got == 0) this_thread::yield();
+                for (size_t i = 0; i < got; ++i) ok = ok && out[i] == expected++;
+            }
+        }
+    });
+    mt19937 rng(1);
+    uint64_t next = 0, batch[11];
+    while (next < n) {
+        uint32_t op = rng() % 3;
+        if (op == 0) {
+            if (q.try_push(next)) ++next;
+            else this_thread::yield();
+        } else if (op == 1) {
+            q.push(next++);
+        } else {
+            size_t count = min<uint64_t>(1 + rng() % 11, n - next);
+            for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+            size_t pushed = q.push_n(batch, count);
+            if (pushed == 0) this_thread::yield();
+            next += pushed;
+        }
+    }
+    consumer.join();
+    return ok && q.size_approx() == 0;
+}
+
+template <typename Queue>
+double throughputSingle(Queue& q, size_t n) {
+    auto start = chrono::steady_clock::now();
+    long long sum = 0;
+    thread consumer([&q, &sum, n]() {
+        for (size_t i = 0; i < n; ++i) sum += q.pop();
+    });
+    for (size_t i = 0; i < n; ++i) q.push(static_cast<int>(i));
+    consumer.join();
+    auto end = chrono::steady_clock::now();
+    if (sum == 42) cout << "";
+    return n / chrono::duration<double>(end - start).count() / 1e6;
+}
+
+double throughputBatched(SpscQueue<int>& q, size_t n, size_t batch) {
+    auto start = chrono::steady_clock::now();
+    long long sum = 0;
+    thread consumer([&q, &sum, n, batch]() {
+        vector<int> out(batch);
+        size_t received = 0;
+        while (received < n) {
+            size_t got = q.pop_n(out.data(), batch);
+            if (got == 0) this_thread::yield();
+            for (size_t i = 0; i < got; ++i) sum += out[i];
+            received += got;
+        }
+    });
+    vector<int> values(batch);
+    size_t sent = 0;
+    while (sent < n) {
+        size_t count = n - sent < batch ? n - sent : batch;
+        for (size_t i = 0; i < count; ++i) values[i] = static_cast<int>(sent + i);
+        size_t pushed = q.push_n(values.data(), count);
+        if (pushed == 0) this_thread::yield();
+        sent += pushed;
+    }
+    consumer.join();
+    auto end = chrono::steady_clock::now();
+    if (sum == 42) cout << "";
+    return n / chrono::duration<double>(end - start).count() / 1e6;
+}
+
+// Round trip latency: ping through one queue, pong back through another
+template <typename Queue>
+double roundTripMicros(Queue& ping, Queue& pong, size_t rounds) {
+    thread echo([&ping, &pong, rounds]() {
+        for (size_t i = 0; i < rounds; ++i) pong.push(ping.pop());
+    });
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        ping.push(static_cast<int>(i));
+        pong.pop();
+    }
+    auto end = chrono::steady_clock::now();
+    echo.join();
+    return chrono::duration<double, micro>(end - start).count() / rounds;
+}
+
+void spscBenchmark() {
+    const size_t n = 20000000;
+    const size_t rounds = 20000;
+    cout << "\nThroughput, " << n << " ints producer -> consumer (M items/s):\n";
+    {
+        LockedQueue<int> q;
+        cout << "  mutex + queue<int>:        " << throughputSingle(q, n) << endl;
+    }
+    {
+        SpscQueue<int> q(4096);
+        cout << "  SpscQueue push/pop:        " << throughputSingle(q, n) << endl;
+    }
+    {
+        SpscQueue<int> q(4096);
+        cout << "  SpscQueue push_n/pop_n 64: " << throughputBatched(q, n, 64) << endl;
+    }
+
+    cout << "Round trip latency over " << rounds << " ping-pongs (us):\n";
+    {
+        LockedQueue<int> ping, pong;
+        cout << "  mutex + queue<int>: " << roundTripMicros(ping, pong, rounds) << endl;
+    }
+    {
+        SpscQueue<int> ping(64), pong(64);
+        cout << "  SpscQueue:          " << roundTripMicros(ping, pong, rounds) << endl;
+    }
+}
+
+int main() {
+    spscUsage();
+    cout << "SPSC self-check (two threads, wraparound, batches): " << (spscSelfCheck() ? "passed" : "FAILED") << endl;
+    spscBenchmark();
+    return 0;
+}
@@ -0,0 +1,455 @@
+#include <iostream>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Work-Stealing Deque and Thread Pool:
+ *
+ * 1. **Chase-Lev deque** (ChaseLevDeque<T>):
+ *    - The dequeUsage() access pattern split between threads: the owner thread uses the bottom
+ *      end like a stack (push / take, LIFO, good cache locality), other threads steal from the
+ *      top end (FIFO, they get the oldest and usually biggest pieces of work).
+ *    - Lock-free: the owner only needs a CAS when it races a thief for the very last element.
+ *    - Grows by doubling; retired arrays are kept until the deque is destroyed, since a thief
+ *      may still be reading one.
+ *
+ * 2. **WorkStealingPool**:
+ *    - One deque per worker. A worker runs its own tasks first, then steals from a random other
+ *      worker, then takes from the shared queue fed by non-worker threads. Idle workers sleep on
+ *      a condition variable and are only notified when somebody is actually asleep.
+ *    - submit(f): runs f on the pool, returns a future with its result.
+ *    - parallel_for(begin, end, grain, body): splits [begin, end) recursively and calls
+ *      body(i) for every i.
+ *    - TaskGroup: spawn(f) forks a task, sync() joins all tasks of the group. While waiting,
+ *      sync() runs other tasks instead of blocking, so recursive fork-join never deadlocks.
+ *    - Exceptions: submit() delivers them through the future. A TaskGroup keeps the first
+ *      exception its tasks throw and sync() rethrows it once every task has finished, so
+ *      parallel_for passes a throwing body's exception on to its caller.
+ */
+
+template <typename T>
+class ChaseLevDeque {
+private:
+    struct Array {
+        int64_t capacity;
+        unique_ptr<atomic<T>[]> slots;
+
+        Array(int64_t n) : capacity(n), slots(new atomic<T>[n]) {}
+        T get(int64_t i) const { return slots[i & (capacity - 1)].load(memory_order_relaxed); }
+        void put(int64_t i, T value) { slots[i & (capacity - 1)].store(value, memory_order_relaxed); }
+    };
+
+    alignas(64) atomic<int64_t> top;    // Thieves take from here
+    alignas(64) atomic<int64_t> bottom; // The owner pushes and takes here
+    atomic<Array*> array;
+    vector<unique_ptr<Array>> arrays;   // Every array ever used, freed with the deque
+
+    Array* grow(Array* old, int64_t b, int64_t t) {
+        arrays.emplace_back(new Array(old->capacity * 2));
+        Array* bigger = arrays.back().get();
+        for (int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        array.store(bigger, memory_order_release);
+        return bigger;
+    }
+
+public:
+    explicit ChaseLevDeque(int64_t capacity = 256) : top(0), bottom(0) {
+        arrays.emplace_back(new Array(capacity));
+        array.store(arrays.back().get(), memory_order_relaxed);
+    }
+
+    // Owner only
+    void push(T value) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        Array* a = array.load(memory_order_relaxed);
+        if (b - t > a->capacity - 1) a = grow(a, b, t);
+        a->put(b, value);
+        bottom.store(b + 1, memory_order_release); // Publishes the slot to thieves
+    }
+
+    // Owner only; false when empty
+    bool take(T& out) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        Array* a = array.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed); // Was already empty
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            bottom.store(b + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread; false when empty or when another thief won the race
+    bool steal(T& out) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) return false;
+        Array* a = array.load(memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return false;
+        out = value;
+        return true;
+    }
+
+    int64_t size_approx() const {
+        int64_t n = bottom.load(memory_order_relaxed) - top.load(memory_order_relaxed);
+        return n > 0 ? n : 0;
+    }
+};
+
+class WorkStealingPool {
+private:
+    using Task = function<void()>;
+
+    struct Worker {
+        ChaseLevDeque<Task*> tasks;
+        thread handle;
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    mutex injectLock;              // Guards the queue used by non-worker threads
+    deque<Task*> injected;
+    atomic<size_t> injectedCount;
+
+    mutex sleepLock;
+    condition_variable wake;
+    atomic<int> sleepers;
+    atomic<uint64_t> epoch;        // Bumped under sleepLock when new work may wake a sleeper
+    atomic<bool> stopping;
+
+    // Which pool and worker the current thread belongs to, if any
+    static WorkStealingPool*& currentPool() {
+        thread_local WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+
+    static int& currentIndex() {
+        thread_local int index = -1;
+        return index;
+    }
+
+    int myIndex() const { return currentPool() == this ? currentIndex() : -1; }
+
+    static size_t randomIndex(size_t n) {
+        thread_local unsigned long long state =
+            0x2545F4914F6CDD1DULL ^ hash<thread::id>()(this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<size_t>(state % n);
+    }
+
+    void notifySleepers() {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (sleepers.load(memory_order_relaxed) == 0) return;
+        {
+            lock_guard<mutex> guard(sleepLock);
+            epoch.fetch_add(1, memory_order_relaxed);
+        }
+        wake.notify_one();
+    }
+
+    void enqueue(Task* task) {
+        int me = myIndex();
+        if (me >= 0) {
+            workers[me]->tasks.push(task);
+        } else {
+            lock_guard<mutex> guard(injectLock);
+            injected.push_back(task);
+            injectedCount.fetch_add(1, memory_order_relaxed);
+        }
+        notifySleepers();
+    }
+
+    // Own deque first, then steal, then the shared queue
+    Task* findTask() {
+        Task* task = nullptr;
+        int me = myIndex();
+        if (me >= 0 && workers[me]->tasks.take(task)) return task;
+        size_t n = workers.size();
+        size_t start = randomIndex(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t victim = (start + i) % n;
+            if (static_cast<int>(victim) == me) continue;
+            if (workers[victim]->tasks.steal(task)) return task;
+        }
+        if (injectedCount.load(memory_order_relaxed) > 0) {
+            lock_guard<mutex> guard(injectLock);
+            if (!injected.empty()) {
+                task = injected.front();
+                injected.pop_front();
+                injectedCount.fetch_sub(1, memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    static void run(Task* task) {
+        (*task)();
+        delete task;
+    }
+
+    void workerLoop(int index) {
+        currentPool() = this;
+        currentIndex() = index;
+        while (!stopping.load(memory_order_acquire)) {
+            Task* task = findTask();
+            for (int spin = 0; !task && spin < 32; ++spin) {
+                this_thread::yield();
+                task = findTask();
+            }
+            if (task) {
+                run(task);
+                continue;
+            }
+            // Announce that we are going to sleep, then look one last time
+            sleepers.fetch_add(1, memory_order_seq_cst);
+            uint64_t seen = epoch.load(memory_order_relaxed);
+            task = findTask();
+            if (task) {
+                sleepers.fetch_sub(1, memory_order_relaxed);
+                run(task);
+                continue;
+            }
+            {
+                unique_lock<mutex> guard(sleepLock);
+                wake.wait(guard, [this, seen]() {
+                    return epoch.load(memory_order_relaxed) != seen || stopping.load(memory_order_relaxed);
+                });
+            }
+            sleepers.fetch_sub(1, memory_order_relaxed);
+        }
+    }
+
+public:
+    explicit WorkStealingPool(size_t threads = thread::hardware_concurrency())
+        : injectedCount(0), sleepers(0), epoch(0), stopping(false) {
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; ++i) workers.emplace_back(new Worker());
+        for (size_t i = 0; i < threads; ++i) {
+            workers[i]->handle = thread(&WorkStealingPool::workerLoop, this, static_cast<int>(i));
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> guard(sleepLock);
+            stopping.store(true, memory_order_release);
+            epoch.fetch_add(1, memory_order_relaxed);
+        }
+        wake.notify_all();
+        for (auto& w : workers) w->handle.join();
+        Task* task = nullptr;
+        for (auto& w : workers) {
+            while (w->tasks.take(task)) delete task;
+        }
+        for (Task* t : injected) delete t;
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    template <typename F>
+    auto submit(F f) -> future<decltype(f())> {
+        using Result = decltype(f());
+        auto job = make_shared<packaged_task<Result()>>(move(f));
+        future<Result> result = job->get_future();
+        enqueue(new Task([job]() { (*job)(); }));
+        return result;
+    }
+
+    // Fire-and-forget version used by TaskGroup
+    void post(Task f) {
+        enqueue(new Task(move(f)));
+    }
+
+    // Run one pending task on the calling thread; false if none was found
+    bool helpOnce() {
+        Task* task = findTask();
+        if (!task) return false;
+        run(task);
+        return true;
+    }
+
+    size_t size() const { return workers.size(); }
+
+    template <typename Body>
+    void parallel_for(int64_t begin, int64_t end, int64_t grain, const Body& body);
+};
+
+// Fork-join scope: spawn() any number of tasks, then sync() waits for all of them
+class TaskGroup {
+private:
+    WorkStealingPool& pool;
+    atomic<int64_t> pending;
+    mutex errorLock;
+    exception_ptr error; // First exception thrown by a task of this group
+
+    // Helps with other work until every spawned task has finished
+    void wait() {
+        while (pending.load(memory_order_acquire) > 0) {
+            if (!pool.helpOnce()) this_thread::yield();
+        }
+    }
+
+public:
+    explicit TaskGroup(WorkStealingPool& p) : pool(p), pending(0) {}
+
+    // Waits but cannot rethrow; call sync() to see task exceptions
+    ~TaskGroup() {
+        wait();
+    }
+
+    template <typename F>
+    void spawn(F f) {
+        pending.fetch_add(1, memory_order_relaxed);
+        pool.post([this, f]() {
+            try {
+                f();
+            } catch (...) {
+                lock_guard<mutex> lock(errorLock);
+                if (!error) error = current_exception();
+            }
+            pending.fetch_sub(1, memory_order_release);
+        });
+    }
+
+    // Waits for every spawned task, then rethrows the first exception one of them threw
+    void sync() {
+        wait();
+        exception_ptr failure;
+        {
+            lock_guard<mutex> lock(errorLock);
+            swap(failure, error);
+        }
+        if (failure) rethrow_exception(failure);
+    }
+};
+
+template <typename Body>
+void WorkStealingPool::parallel_for(int64_t begin, int64_t end, int64_t grain, const Body& body) {
+    if (grain < 1) grain = 1;
+    function<void(int64_t, int64_t)> split = [&](int64_t lo, int64_t hi) {
+        if (hi - lo <= grain) {
+            for (int64_t i = lo; i < hi; ++i) body(i);
+            return;
+        }
+        int64_t mid = lo + (hi - lo) / 2;
+        TaskGroup group(*this);
+        group.spawn([&split, mid, hi]() { split(mid, hi); }); // Right half may be stolen
+        split(lo, mid);                                      // Left half runs here
+        group.sync();
+    };
+    split(begin, end);
+}
+
+long long fibSequential(int n) {
+    return n < 2 ? n : fibSequential(n - 1) + fibSequential(n - 2);
+}
+
+// Recursive fork-join: below the cutoff the task is too small to be worth spawning
+long long fibParallel(WorkStealingPool& pool, int n, int cutoff) {
+    if (n <= cutoff) return fibSequential(n);
+    long long a = 0;
+    TaskGroup group(pool);
+    group.spawn([&pool, &a, n, cutoff]() { a = fibParallel(pool, n - 1, cutoff); });
+    long long b = fibParallel(pool, n - 2, cutoff);
+    group.sync();
+    return a + b;
+}
+
+void workStealingUsage() {
+    // Deque used by a single thread behaves like dequeUsage(): take() is LIFO, steal() is FIFO
+    ChaseLevDeque<int> d;
+    d.push(10);
+    d.push(20);
+    d.push(30);
+    int value = 0;
+    d.steal(value);
+    cout << "Stolen from top: " << value << endl; // Output: 10
+    d.take(value);
+    cout << "Taken from bottom: " << value << endl; // Output: 30
+
+    WorkStealingPool pool(4);
+    auto answer = pool.submit([]() { return 6 * 7; });
+    cout << "submit result: " << answer.get() << endl; // Output: 42
+
+    vector<int> squares(10);
+    pool.parallel_for(0, 10, 2, [&squares](int64_t i) { squares[i] = static_cast<int>(i * i); });
+    cout << "parallel_for squares: ";
+    for (int n : squares) cout << n << " "; // Output: 0 1 4 9 16 25 36 49 64 81
+    cout << endl;
+
+    cout << "fib(25) with spawn/sync: " << fibParallel(pool, 25, 10) << endl; // Output: 75025
+
+    // An exception in any task reaches the caller once the whole loop has stopped
+    try {
+        pool.parallel_for(0, 1000, 10, [](int64_t i) {
+            if (i == 777) throw runtime_error("bad item 777");
+        });
+    } catch (const exception& e) {
+        cout << "parallel_for threw: " << e.what() << endl; // Output: bad item 777
+    }
+}
+
+void workStealingBenchmark() {
+    const int n = 36;
+    const int cutoff = 20;
+    auto start = chrono::steady_clock::now();
+    long long expected = fibSequential(n);
+    double sequentialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "\nRecursive fib(" << n << "), hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << "  sequential: " << sequentialMs << " ms\n";
+
+    const int64_t items = 20000000;
+    for (size_t threads : {1u, 2u, 4u, 8u}) {
+        WorkStealingPool pool(threads);
+
+        start = chrono::steady_clock::now();
+        long long result = fibParallel(pool, n, cutoff);
+        double fibMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // parallel_for over an array; each element does a little arithmetic
+        vector<double> data(items);
+        start = chrono::steady_clock::now();
+        pool.parallel_for(0, items, 65536, [&data](int64_t i) {
+            double x = static_cast<double>(i);
+            data[i] = x * x * 0.5 + x;
+        });
+        double forMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << "  " << threads << " threads: fib " << fibMs << " ms (speedup " << sequentialMs / fibMs
+             << (result == expected ? "" : ", WRONG RESULT") << "), parallel_for " << forMs << " ms\n";
+    }
+}
+
+int main() {
+    workStealingUsage();
+    workStealingBenchmark();
+    return 0;
+}
@@ -0,0 +1,856 @@
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Adaptive Radix Tree (ART):
+ *
+ * 1. **Problem**:
+ *    - map<string, int> compares whole strings at every level of the red-black tree. Keys like
+ *      "user:000123456:profile" or "/srv/data/project-17/..." share long prefixes, so each of the
+ *      ~20 comparisons of a lookup re-reads the same leading bytes.
+ *
+ * 2. **AdaptiveRadixTree<Value>**:
+ *    - A trie over the key bytes: each inner node consumes one byte, so a lookup touches every
+ *      key byte once, no matter how many keys there are.
+ *    - Path compression: a run of single-child levels is stored as a `prefix` string in the node.
+ *    - Adaptive nodes: an inner node is a Node4, Node16, Node48 or Node256 depending on how many
+ *      children it has, and grows or shrinks as keys come and go.
+ *        - Node4/Node16: sorted byte array + child array. Node16 is searched with one SSE2
+ *          compare of all 16 bytes.
+ *        - Node48: 256-entry byte -> slot index, 48 child pointers.
+ *        - Node256: child pointer per byte.
+ *    - Leaves hold the (key, value) pair. A key that is a prefix of other keys (e.g. "ab" and
+ *      "abc") is stored as the `terminal` leaf of the node where it ends.
+ *
+ * 3. **Operations**:
+ *    - operator[], insert, find (returns Value* or nullptr), count, erase, size, empty, clear.
+ *      find, count, lower_bound and prefix_range also work on a const tree, returning
+ *      const Value* and const_iterator.
+ *    - Ordered iteration (byte-wise lexicographic order, same as map<string, ...>), lower_bound,
+ *      and prefix_range(prefix) which returns the [first, last) iterators of all keys starting
+ *      with prefix.
+ */
+
+template <typename Value>
+class AdaptiveRadixTree {
+public:
+    using value_type = pair<const string, Value>;
+
+private:
+    enum NodeType : uint8_t { Type4, Type16, Type48, Type256 };
+
+    // A child reference is either a Node* or a value_type* with the low bit set
+    using Ref = void*;
+
+    struct Node {
+        NodeType type;
+        uint16_t children;
+        string prefix;        // Compressed path below the byte that led here
+        value_type* terminal; // Key that ends exactly at this node
+
+        explicit Node(NodeType t) : type(t), children(0), terminal(nullptr) {}
+    };
+
+    struct Node4 : Node {
+        uint8_t keys[4];
+        Ref child[4];
+        Node4() : Node(Type4) {}
+    };
+
+    struct Node16 : Node {
+        uint8_t keys[16];
+        Ref child[16];
+        Node16() : Node(Type16) {}
+    };
+
+    struct Node48 : Node {
+        uint8_t index[256]; // byte -> slot + 1, 0 means no child
+        Ref child[48];
+        Node48() : Node(Type48) { memset(index, 0, sizeof(index)); }
+    };
+
+    struct Node256 : Node {
+        Ref child[256];
+        Node256() : Node(Type256) { fill(child, child + 256, nullptr); }
+    };
+
+    Ref root;
+    size_t elements;
+
+    static bool isLeaf(Ref r) { return reinterpret_cast<uintptr_t>(r) & 1; }
+    static value_type* asLeaf(Ref r) { return reinterpret_cast<value_type*>(reinterpret_cast<uintptr_t>(r) & ~uintptr_t(1)); }
+    static Ref tag(value_type* leaf) { return reinterpret_cast<Ref>(reinterpret_cast<uintptr_t>(leaf) | 1); }
+    static Node* asNode(Ref r) { return static_cast<Node*>(r); }
+
+    static void freeNode(Node* n) {
+        switch (n->type) {
+            case Type4: delete static_cast<Node4*>(n); break;
+            case Type16: delete static_cast<Node16*>(n); break;
+            case Type48: delete static_cast<Node48*>(n); break;
+            case Type256: delete static_cast<Node256*>(n); break;
+        }
+    }
+
+    static void destroy(Ref r) {
+        if (!r) return;
+        if (isLeaf(r)) {
+            delete asLeaf(r);
+            return;
+        }
+        Node* n = asNode(r);
+        delete n->terminal;
+        forEachChild(n, [](uint8_t, Ref c) { destroy(c); });
+        freeNode(n);
+    }
+
+    // Calls f(byte, child) for every child in byte order
+    template <typename F>
+    static void forEachChild(Node* n, F f) {
+        switch (n->type) {
+            case Type4: {
+                auto* x = static_cast<Node4*>(n);
+                for (int i = 0; i < n->children; ++i) f(x->keys[i], x->child[i]);
+                break;
+            }
+            case Type16: {
+                auto* x = static_cast<Node16*>(n);
+                for (int i = 0; i < n->children; ++i) f(x->keys[i], x->child[i]);
+                break;
+            }
+            case Type48: {
+                auto* x = static_cast<Node48*>(n);
+                for (int b = 0; b < 256; ++b) {
+                    if (x->index[b]) f(static_cast<uint8_t>(b), x->child[x->index[b] - 1]);
+                }
+                break;
+            }
+            case Type256: {
+                auto* x = static_cast<Node256*>(n);
+                for (int b = 0; b < 256; ++b) {
+                    if (x->child[b]) f(static_cast<uint8_t>(b), x->child[b]);
+                }
+                break;
+            }
+        }
+    }
+
+    static Ref* findChild(Node* n, uint8_t b) {
+        switch (n->type) {
+            case Type4: {
+                auto* x = static_cast<Node4*>(n);
+                for (int i = 0; i < n->children; ++i) {
+                    if (x->keys[i] == b) return &x->child[i];
+                }
+                return nullptr;
+            }
+            case Type16: {
+                auto* x = static_cast<Node16*>(n);
+#ifdef __SSE2__
+                // Compare all 16 key bytes at once, mask off the unused slots
+                __m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(b)),
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(x->keys)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << n->children) - 1);
+                return mask ? &x->child[__builtin_ctz(mask)] : nullptr;
+#else
+                for (int i = 0; i < n->children; ++i) {
+                    if (x->keys[i] == b) return &x->child[i];
+                }
+                return nullptr;
+#endif
+            }
+            case Type48: {
+                auto* x = static_cast<Node48*>(n);
+                return x->index[b] ? &x->child[x->index[b] - 1] : nullptr;
+            }
+            case Type256: {
+                auto* x = static_cast<Node256*>(n);
+                return x->child[b] ? &x->child[b] : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename Small>
+    static void insertSorted(Small* x, uint8_t b, Ref c) {
+        int i = x->children;
+        while (i > 0 && x->keys[i - 1] > b) {
+            x->keys[i] = x->keys[i - 1];
+            x->child[i] = x->child[i - 1];
+            --i;
+        }
+        x->keys[i] = b;
+        x->child[i] = c;
+        ++x->children;
+    }
+
+    template <typename Small>
+    static void removeSorted(Small* x, int i) {
+        for (; i + 1 < x->children; ++i) {
+            x->keys[i] = x->keys[i + 1];
+            x->child[i] = x->child[i + 1];
+        }
+        --x->children;
+    }
+
+    // Moves prefix, terminal and every child of `from` into the empty node `to`, then frees `from`
+    template <typename Target>
+    static Target* convert(Node* from) {
+        Target* to = new Target();
+        to->prefix = move(from->prefix);
+        to->terminal = from->terminal;
+        forEachChild(from, [to](uint8_t b, Ref c) { addTo(to, b, c); });
+        freeNode(from);
+        return to;
+    }
+
+    static void addTo(Node4* x, uint8_t b, Ref c) { insertSorted(x, b, c); }
+    static void addTo(Node16* x, uint8_t b, Ref c) { insertSorted(x, b, c); }
+
+    static void addTo(Node48* x, uint8_t b, Ref c) {
+        x->child[x->children] = c; // Slots are kept compact: 0 .. children-1
+        x->index[b] = static_cast<uint8_t>(++x->children);
+    }
+
+    static void addTo(Node256* x, uint8_t b, Ref c) {
+        x->child[b] = c;
+        ++x->children;
+    }
+
+    // Adds child c under byte b, replacing the node in `ref` with a bigger one if it is full
+    static void addChild(Ref& ref, uint8_t b, Ref c) {
+        Node* n = asNode(ref);
+        switch (n->type) {
+            case Type4:
+                if (n->children < 4) return addTo(static_cast<Node4*>(n), b, c);
+                ref = n = convert<Node16>(n);
+                return addTo(static_cast<Node16*>(n), b, c);
+            case Type16:
+                if (n->children < 16) return addTo(static_cast<Node16*>(n), b, c);
+                ref = n = convert<Node48>(n);
+                return addTo(static_cast<Node48*>(n), b, c);
+            case Type48:
+                if (n->children < 48) return addTo(static_cast<Node48*>(n), b, c);
+                ref = n = convert<Node256>(n);
+                return addTo(static_cast<Node256*>(n), b, c);
+            case Type256:
+                return addTo(static_cast<Node256*>(n), b, c);
+        }
+    }
+
+    // Removes the child under byte b, replacing the node in `ref` with a smaller one when it gets sparse
+    static void removeChild(Ref& ref, uint8_t b) {
+        Node* n = asNode(ref);
+        switch (n->type) {
+            case Type4: {
+                auto* x = static_cast<Node4*>(n);
+                removeSorted(x, static_cast<int>(std::find(x->keys, x->keys + n->children, b) - x->keys));
+                break;
+            }
+            case Type16: {
+                auto* x = static_cast<Node16*>(n);
+                removeSorted(x, static_cast<int>(std::find(x->keys, x->keys + n->children, b) - x->keys));
+                if (n->children <= 3) ref = convert<Node4>(n);
+                break;
+            }
+            case Type48: {
+                auto* x = static_cast<Node48*>(n);
+                int slot = x->index[b] - 1;
+                int last = --x->children;
+                x->index[b] = 0;
+                if (slot != last) {
+                    // Move the last slot into the hole so the slots stay compact
+                    x->child[slot] = x->child[last];
+                    for (int k = 0; k < 256; ++k) {
+                        if (x->index[k] == last + 1) {
+                            x->index[k] = static_cast<uint8_t>(slot + 1);
+                            break;
+                        }
+                    }
+                }
+                if (n->children <= 12) ref = convert<Node16>(n);
+                break;
+            }
+            case Type256: {
+                auto* x = static_cast<Node256*>(n);
+                x->child[b] = nullptr;
+                --x->children;
+                if (n->children <= 37) ref = convert<Node48>(n);
+                break;
+            }
+        }
+    }
+
+    // After an erase: drop empty nodes and merge a single child back into its parent's path
+    static void collapse(Ref& ref) {
+        Node* n = asNode(ref);
+        if (n->children == 0) {
+            ref = n->terminal ? tag(n->terminal) : nullptr;
+            freeNode(n);
+        } else if (n->children == 1 && !n->terminal) {
+            uint8_t byte = 0;
+            Ref only = nullptr;
+            forEachChild(n, [&](uint8_t b, Ref c) { byte = b; only = c; });
+            if (!isLeaf(only)) {
+                Node* c = asNode(only);
+                c->prefix = n->prefix + static_cast<char>(byte) + c->prefix;
+            }
+            ref = only;
+            freeNode(n);
+        }
+    }
+
+    static value_type* newLeaf(string_view key) {
+        return new value_type(string(key), Value());
+    }
+
+    // Puts a leaf into a freshly split Node4 whose path ends at depth
+    static void placeLeaf(Node4* n, value_type* leaf, size_t depth) {
+        if (leaf->first.size() == depth) n->terminal = leaf;
+        else insertSorted(n, static_cast<uint8_t>(leaf->first[depth]), tag(leaf));
+    }
+
+    value_type* insertAt(Ref& ref, string_view key, size_t depth, bool& inserted) {
+        if (!ref) {
+            value_type* leaf = newLeaf(key);
+            ref = tag(leaf);
+            inserted = true;
+            return leaf;
+        }
+        if (isLeaf(ref)) {
+            value_type* existing = asLeaf(ref);
+            const string& other = existing->first;
+            if (other == key) return existing;
+            // Replace the leaf by a node holding both keys, compressing their shared bytes
+            size_t limit = min(other.size(), key.size());
+            size_t common = depth;
+            while (common < limit && other[common] == key[common]) ++common;
+            Node4* n = new Node4();
+            n->prefix.assign(key.data() + depth, common - depth);
+            value_type* leaf = newLeaf(key);
+            placeLeaf(n, existing, common);
+            placeLeaf(n, leaf, common);
+            ref = n;
+            inserted = true;
+            return leaf;
+        }
+        Node* n = asNode(ref);
+        const string& prefix = n->prefix;
+        size_t matched = 0;
+        while (matched < prefix.size() && depth + matched < key.size() && prefix[matched] == key[depth + matched]) ++matched;
+        if (matched < prefix.size()) {
+            // The key leaves the compressed path part-way: split the path at the mismatch
+            Node4* parent = new Node4();
+            parent->prefix = prefix.substr(0, matched);
+            uint8_t byte = static_cast<uint8_t>(prefix[matched]);
+            n->prefix.erase(0, matched + 1);
+            insertSorted(parent, byte, n);
+            value_type* leaf = newLeaf(key);
+            placeLeaf(parent, leaf, depth + matched);
+            ref = parent;
+            inserted = true;
+            return leaf;
+        }
+        depth += prefix.size();
+        if (depth == key.size()) {
+            if (!n->terminal) {
+                n->terminal = newLeaf(key);
+                inserted = true;
+            }
+            return n->terminal;
+        }
+        uint8_t byte = static_cast<uint8_t>(key[depth]);
+        if (Ref* slot = findChild(n, byte)) return insertAt(*slot, key, depth + 1, inserted);
+        value_type* leaf = newLeaf(key);
+        addChild(ref, byte, tag(leaf));
+        inserted = true;
+        return leaf;
+    }
+
+    bool eraseAt(Ref& ref, string_view key, size_t depth) {
+        if (!ref) return false;
+        if (isLeaf(ref)) {
+            if (asLeaf(ref)->first != key) return false;
+            delete asLeaf(ref);
+            ref = nullptr;
+            return true;
+        }
+        Node* n = asNode(ref);
+        const string& prefix = n->prefix;
+        if (key.size() - depth < prefix.size() || key.compare(depth, prefix.size(), prefix) != 0) return false;
+        depth += prefix.size();
+        if (depth == key.size()) {
+            if (!n->terminal) return false;
+            delete n->terminal;
+            n->terminal = nullptr;
+            collapse(ref);
+            return true;
+        }
+        uint8_t byte = static_cast<uint8_t>(key[depth]);
+        Ref* slot = findChild(n, byte);
+        if (!slot || !eraseAt(*slot, key, depth + 1)) return false;
+        if (!*slot) removeChild(ref, byte);
+        collapse(ref);
+        return true;
+    }
+
+    // One level of an iterator's path; shared so that iterator converts to const_iterator
+    struct Frame {
+        Node* node;
+        int pos; // -1: terminal not visited yet; otherwise next child position (index or byte)
+    };
+
+public:
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<const string, Value>;
+        using difference_type = ptrdiff_t;
+        using pointer = typename conditional<Const, const value_type*, value_type*>::type;
+        using reference = typename conditional<Const, const value_type&, value_type&>::type;
+
+    private:
+        friend class AdaptiveRadixTree;
+        template <bool> friend class Iterator;
+
+        vector<Frame> stack;
+        value_type* current = nullptr;
+
+        // Next child of the frame in key order, or nullptr when the node is exhausted
+        static Ref nextChild(Frame& f) {
+            Node* n = f.node;
+            if (f.pos < 0) {
+                f.pos = 0;
+                if (n->terminal) return tag(n->terminal);
+            }
+            switch (n->type) {
+                case Type4:
+                    return f.pos < n->children ? static_cast<Node4*>(n)->child[f.pos++] : nullptr;
+                case Type16:
+                    return f.pos < n->children ? static_cast<Node16*>(n)->child[f.pos++] : nullptr;
+                case Type48: {
+                    auto* x = static_cast<Node48*>(n);
+                    while (f.pos < 256) {
+                        uint8_t slot = x->index[f.pos++];
+                        if (slot) return x->child[slot - 1];
+                    }
+                    return nullptr;
+                }
+                case Type256: {
+                    auto* x = static_cast<Node256*>(n);
+                    while (f.pos < 256) {
+                        Ref c = x->child[f.pos++];
+                        if (c) return c;
+                    }
+                    return nullptr;
+                }
+            }
+            return nullptr;
+        }
+
+        // Moves to the next leaf after the positions recorded on the stack
+        void advance() {
+            while (!stack.empty()) {
+                Ref r = nextChild(stack.back());
+                if (!r) {
+                    stack.pop_back();
+                } else if (isLeaf(r)) {
+                    current = asLeaf(r);
+                    return;
+                } else {
+                    stack.push_back({asNode(r), -1});
+                }
+            }
+            current = nullptr;
+        }
+
+        // Positions the iterator on the first leaf of the subtree r (continuing after it if empty)
+        void enter(Ref r) {
+            if (r && isLeaf(r)) {
+                current = asLeaf(r);
+                return;
+            }
+            if (r) stack.push_back({asNode(r), -1});
+            advance();
+        }
+
+    public:
+        Iterator() = default;
+
+        operator Iterator<true>() const {
+            Iterator<true> it;
+            it.stack = stack;
+            it.current = current;
+            return it;
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return current; }
+
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            advance();
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return current == other.current; }
+        bool operator!=(const Iterator& other) const { return current != other.current; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    AdaptiveRadixTree() : root(nullptr), elements(0) {}
+
+    ~AdaptiveRadixTree() {
+        destroy(root);
+    }
+
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+    Value& operator[](string_view key) {
+        bool inserted = false;
+        value_type* leaf = insertAt(root, key, 0, inserted);
+        elements += inserted;
+        return leaf->second;
+    }
+
+    // Does not overwrite an existing key, like map::insert; returns true if the key was added
+    bool insert(string_view key, const Value& value) {
+        bool inserted = false;
+        value_type* leaf = insertAt(root, key, 0, inserted);
+        if (inserted) {
+            leaf->second = value;
+            ++elements;
+        }
+        return inserted;
+    }
+
+    Value* find(string_view key) {
+        value_type* leaf = findLeaf(key);
+        return leaf ? &leaf->second : nullptr;
+    }
+
+    const Value* find(string_view key) const {
+        const value_type* leaf = findLeaf(key);
+        return leaf ? &leaf->second : nullptr;
+    }
+
+    size_t count(string_view key) const {
+        return findLeaf(key) ? 1 : 0;
+    }
+
+    size_t erase(string_view key) {
+        if (!eraseAt(root, key, 0)) return 0;
+        --elements;
+        return 1;
+    }
+
+    iterator begin() { return beginIn<iterator>(); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return beginIn<const_iterator>(); }
+    const_iterator end() const { return const_iterator(); }
+
+    // First element whose key is >= key
+    iterator lower_bound(string_view key) { return lowerBoundIn<iterator>(key); }
+    const_iterator lower_bound(string_view key) const { return lowerBoundIn<const_iterator>(key); }
+
+    // All elements whose key starts with prefix, as [first, last)
+    pair<iterator, iterator> prefix_range(string_view prefix) { return prefixRangeIn<iterator>(prefix); }
+    pair<const_iterator, const_iterator> prefix_range(string_view prefix) const {
+        return prefixRangeIn<const_iterator>(prefix);
+    }
+
+    size_t size() const { return elements; }
+    bool empty() const { return elements == 0; }
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        elements = 0;
+    }
+
+private:
+    // The lookups below only read the tree; the const and non-const overloads share them
+    value_type* findLeaf(string_view key) const {
+        Ref r = root;
+        size_t depth = 0;
+        while (r && !isLeaf(r)) {
+            Node* n = asNode(r);
+            const string& prefix = n->prefix;
+            if (key.size() - depth < prefix.size() || memcmp(prefix.data(), key.data() + depth, prefix.size()) != 0) return nullptr;
+            depth += prefix.size();
+            if (depth == key.size()) return n->terminal;
+            Ref* slot = findChild(n, static_cast<uint8_t>(key[depth]));
+            if (!slot) return nullptr;
+            r = *slot;
+            ++depth;
+        }
+        // Only the bytes after `depth` are unchecked, but comparing the whole key is simpler
+        if (r && asLeaf(r)->first == key) return asLeaf(r);
+        return nullptr;
+    }
+
+    template <typename It>
+    It beginIn() const {
+        It it;
+        it.enter(root);
+        return it;
+    }
+
+    template <typename It>
+    It lowerBoundIn(string_view key) const {
+        It it;
+        Ref r = root;
+        size_t depth = 0;
+        while (r) {
+            if (isLeaf(r)) {
+                if (string_view(asLeaf(r)->first) >= key) it.current = asLeaf(r);
+                else it.advance();
+                return it;
+            }
+            Node* n = asNode(r);
+            const string& prefix = n->prefix;
+            size_t remaining = key.size() - depth;
+            size_t len = min(prefix.size(), remaining);
+            int c = memcmp(prefix.data(), key.data() + depth, len);
+            if (c < 0) { // Whole subtree sorts before key
+                it.advance();
+                return it;
+            }
+            if (c > 0 || remaining < prefix.size()) { // Whole subtree sorts after key
+                it.enter(r);
+                return it;
+            }
+            depth += prefix.size();
+            if (depth == key.size()) { // Terminal (if any) equals key, everything below is larger
+                it.enter(r);
+                return it;
+            }
+            // Skip the terminal and every child below key[depth]; descend into key[depth] itself
+            uint8_t byte = static_cast<uint8_t>(key[depth]);
+            int pos;
+            if (n->type == Type4) {
+                auto* x = static_cast<Node4*>(n);
+                pos = static_cast<int>(std::upper_bound(x->keys, x->keys + n->children, byte) - x->keys);
+            } else if (n->type == Type16) {
+                auto* x = static_cast<Node16*>(n);
+                pos = static_cast<int>(std::upper_bound(x->keys, x->keys + n->children, byte) - x->keys);
+            } else {
+                pos = byte + 1;
+            }
+            it.stack.push_back({n, pos});
+            Ref* slot = findChild(n, byte);
+            if (!slot) {
+                it.advance();
+                return it;
+            }
+            r = *slot;
+            ++depth;
+        }
+        it.advance();
+        return it;
+    }
+
+    template <typename It>
+    pair<It, It> prefixRangeIn(string_view prefix) const {
+        // The first key after the range is the prefix with its last non-0xFF byte incremented
+        string next(prefix);
+        while (!next.empty() && static_cast<uint8_t>(next.back()) == 0xFF) next.pop_back();
+        if (next.empty()) return {lowerBoundIn<It>(prefix), It()};
+        next.back() = static_cast<char>(static_cast<uint8_t>(next.back()) + 1);
+        return {lowerBoundIn<It>(prefix), lowerBoundIn<It>(next)};
+    }
+};
+
+// Same steps as mapUsage() in example.cpp, plus the prefix queries
+void adaptiveRadixTreeUsage() {
+    AdaptiveRadixTree<int> m;
+    m["Alice"] = 25;
+    m["Bob"] = 30;
+    m.insert("Charlie", 35);
+    m["Alicia"] = 28;
+    m["Al"] = 60;
+
+    cout << "Map after insertions: ";
+    for (const auto& p : m) cout << p.first << ":" << p.second << " "; // Output: Al:60 Alice:25 Alicia:28 Bob:30 Charlie:35
+    cout << endl;
+
+    if (int* age = m.find("Bob")) cout << "Found Bob with age " << *age << endl; // Output: Found Bob with age 30
+    cout << "Count of David: " << m.count("David") << endl; // Output: 0
+
+    auto range = m.prefix_range("Ali");
+    cout << "Keys starting with Ali: ";
+    for (auto it = range.first; it != range.second; ++it) cout << it->first << " "; // Output: Alice Alicia
+    cout << endl;
+    cout << "First key >= B: " << m.lower_bound("B")->first << endl; // Output: Bob
+
+    m.erase("Bob");
+    cout << "Size of map after erasing Bob: " << m.size() << endl; // Output: 4
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Randomized comparison against map<string, int>, including erase and shrinking nodes
+bool adaptiveRadixTreeSelfCheck() {
+    mt19937 rng(3);
+    AdaptiveRadixTree<int> art;
+    const AdaptiveRadixTree<int>& view = art; // Queries below go through the const overloads
+    map<string, int> reference;
+    const string alphabet = "ab\xff";
+    for (int round = 0; round < 200000; ++round) {
+        string key;
+        size_t len = rng() % 4;
+        for (size_t i = 0; i < len; ++i) key += alphabet[rng() % alphabet.size()];
+        if (rng() % 4 == 0) key += static_cast<char>(rng() % 256); // Wide nodes that grow to Node256 and shrink back
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                art[key] = round;
+                reference[key] = round;
+                break;
+            case 2:
+                if (art.erase(key) != reference.erase(key)) return false;
+                break;
+            case 3: {
+                auto it = art.lower_bound(key);
+                auto expected = reference.lower_bound(key);
+                if ((it == art.end()) != (expected == reference.end())) return false;
+                if (it != art.end() && it->first != expected->first) return false;
+                AdaptiveRadixTree<int>::const_iterator constIt = view.lower_bound(key);
+                if (constIt != AdaptiveRadixTree<int>::const_iterator(it)) return false;
+                const int* value = view.find(key);
+                auto exact = reference.find(key);
+                if ((value != nullptr) != (exact != reference.end())) return false;
+                if (view.count(key) != reference.count(key)) return false;
+                if (value && *value != exact->second) return false;
+                break;
+            }
+        }
+    }
+    if (art.size() != reference.size()) return false;
+    auto it = view.begin();
+    for (const auto& p : reference) {
+        if (it == view.end() || it->first != p.first || it->second != p.second) return false;
+        ++it;
+    }
+    if (it != view.end()) return false;
+    // Every prefix of length <= 1 against a scan of the reference
+    for (int b = -1; b < 256; ++b) {
+        string prefix = b < 0 ? string() : string(1, static_cast<char>(b));
+        auto range = view.prefix_range(prefix);
+        size_t n = 0;
+        for (auto p = range.first; p != range.second; ++p, ++n) {
+            if (p->first.compare(0, prefix.size(), prefix) != 0) return false;
+        }
+        size_t expected = 0;
+        for (const auto& p : reference) expected += p.first.compare(0, prefix.size(), prefix) == 0;
+        if (n != expected) return false;
+    }
+    return true;
+}
+
+// Keys with long shared prefixes: file paths and user records
+vector<string> makeKeys(size_t n, mt19937& rng) {
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            keys.push_back("/srv/data/project-" + to_string(rng() % 100) + "/logs/2024/" + to_string(rng() % 12 + 1) +
+                           "/worker-" + to_string(rng() % 1000) + ".log");
+        } else {
+            string id = to_string(100000000 + rng() % 900000000);
+            keys.push_back("user:" + id + ":profile");
+        }
+    }
+    return keys;
+}
+
+void adaptiveRadixTreeBenchmark() {
+    const size_t n = 1000000;
+    mt19937 rng(7);
+    vector<string> keys = makeKeys(n, rng);
+    vector<string> missing = makeKeys(n / 4, rng);
+    for (auto& k : missing) k += "#";
+    vector<string> lookups(keys);
+    shuffle(lookups.begin(), lookups.end(), rng);
+
+    map<string, int> stdMap;
+    AdaptiveRadixTree<int> art;
+    long long checksum = 0;
+
+    cout << "\n" << n << " path / user-id keys (map<string,int> / AdaptiveRadixTree):\n";
+    double a = timeMs([&]() { for (size_t i = 0; i < n; ++i) stdMap[keys[i]] = static_cast<int>(i); });
+    double b = timeMs([&]() { for (size_t i = 0; i < n; ++i) art[keys[i]] = static_cast<int>(i); });
+    cout << "  insert:         " << a << " / " << b << " ms\n";
+
+    long long sa = 0, sb = 0;
+    a = timeMs([&]() { for (const auto& k : lookups) sa += stdMap.find(k)->second; });
+    b = timeMs([&]() { for (const auto& k : lookups) sb += *art.find(k); });
+    cout << "  find (hit):     " << a << " / " << b << " ms\n";
+    checksum += sa == sb;
+
+    a = timeMs([&]() { for (const auto& k : missing) sa += stdMap.count(k); });
+    b = timeMs([&]() { for (const auto& k : missing) sb += art.count(k); });
+    cout << "  find (miss):    " << a << " / " << b << " ms\n";
+
+    a = timeMs([&]() { for (const auto& p : stdMap) sa += p.first.size(); });
+    b = timeMs([&]() { for (const auto& p : art) sb += p.first.size(); });
+    cout << "  full scan:      " << a << " / " << b << " ms\n";
+
+    // Prefix scans: all logs of one worker month, all users in one id block
+    vector<string> prefixes;
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 2 == 0) prefixes.push_back("/srv/data/project-" + to_string(rng() % 100) + "/logs/2024/" + to_string(rng() % 12 + 1) + "/");
+        else prefixes.push_back("user:" + to_string(100 + rng() % 900) + "1");
+    }
+    size_t ma = 0, mb = 0;
+    a = timeMs([&]() {
+        for (const auto& prefix : prefixes) {
+            for (auto it = stdMap.lower_bound(prefix); it != stdMap.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) ++ma;
+        }
+    });
+    b = timeMs([&]() {
+        for (const auto& prefix : prefixes) {
+            auto range = art.prefix_range(prefix);
+            for (auto it = range.first; it != range.second; ++it) ++mb;
+        }
+    });
+    cout << "  " << prefixes.size() << " prefix scans: " << a << " / " << b << " ms (" << ma << " keys)\n";
+    cout << "  Results agree: " << (sa == sb && ma == mb && stdMap.size() == art.size() ? "Yes" : "No") << endl;
+    if (checksum == 42) cout << ""; // Keep the loops from being optimized away
+}
+
+int main() {
+    adaptiveRadixTreeUsage();
+    cout << "Self-check against map<string, int>: " << (adaptiveRadixTreeSelfCheck() ? "passed" : "FAILED") << endl;
+    adaptiveRadixTreeBenchmark();
+    return 0;
+}
@@ -0,0 +1,734 @@
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <utility>
+
+using namespace std;
+
+/**
+ * B+Tree Ordered Map and Set:
+ *
+ * 1. **Problem**:
+ *    - set and map are red-black trees: one heap node per element, and every level of a lookup
+ *      or every step of a scan is a pointer chase to a new cache line.
+ *
+ * 2. **BPlusTreeMap<Key, Value, Compare>**:
+ *    - All elements live in leaves, stored as sorted arrays of keys (and a parallel array of
+ *      values). Leaves are linked both ways, so a range scan walks arrays, not pointers.
+ *    - Inner nodes hold only separator keys and child pointers. The key arrays are sized to
+ *      about 4 cache lines (64 ints), so a 50M element tree is only 5 levels deep.
+ *    - Nodes split when full and borrow from or merge with a sibling when less than half full.
+ *    - Operations (same as the mapUsage() demo): operator[], insert, emplace, count, find,
+ *      erase(key), erase(iterator), lower_bound, upper_bound, size, empty, clear, begin/end,
+ *      rbegin/rend.
+ *    - Iterators are bidirectional. Because keys and values are stored in separate arrays,
+ *      *it yields a pair<const Key&, Value&> (so it->first / it->second work as with map).
+ *    - erase may rebalance leaves, so erase(iterator) finds its successor again by key:
+ *      O(log n) rather than the amortized O(1) of map::erase(iterator).
+ *
+ * 3. **BPlusTreeSet<Key, Compare>**:
+ *    - The same tree without values, with the setUsage() operations; *it is a const Key&.
+ */
+
+template <typename Key, typename Value, typename Compare = less<Key>>
+class BPlusTreeMap {
+private:
+    static constexpr int NODE_KEY_BYTES = 256; // 4 cache lines of keys per node
+    static constexpr int LEAF_CAP = NODE_KEY_BYTES / sizeof(Key) > 8 ? NODE_KEY_BYTES / sizeof(Key) : 8;
+    static constexpr int INNER_CAP = LEAF_CAP;
+    static constexpr int LEAF_MIN = LEAF_CAP / 2;
+    static constexpr int INNER_MIN = INNER_CAP / 2;
+
+    struct Node {
+        bool isLeaf;
+        int count; // Number of keys
+        Node(bool leaf) : isLeaf(leaf), count(0) {}
+    };
+
+    // One spare slot so a node can overflow by one element before it is split
+    struct Leaf : Node {
+        Key keys[LEAF_CAP + 1];
+        Value values[LEAF_CAP + 1];
+        Leaf* prev;
+        Leaf* next;
+        Leaf() : Node(true), prev(nullptr), next(nullptr) {}
+    };
+
+    // Keys in children[i] are >= keys[i - 1] and < keys[i]
+    struct Inner : Node {
+        Key keys[INNER_CAP + 1];
+        Node* children[INNER_CAP + 2];
+        Inner() : Node(false) {}
+    };
+
+    Node* root;
+    Leaf* head; // Leftmost leaf
+    Leaf* tail; // Rightmost leaf
+    size_t elements;
+    Compare comp;
+
+    static Leaf* asLeaf(Node* n) { return static_cast<Leaf*>(n); }
+    static Inner* asInner(Node* n) { return static_cast<Inner*>(n); }
+
+    int leafLowerBound(const Leaf* leaf, const Key& key) const {
+        return static_cast<int>(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key, comp) - leaf->keys);
+    }
+
+    int childIndex(const Inner* inner, const Key& key) const {
+        return static_cast<int>(std::upper_bound(inner->keys, inner->keys + inner->count, key, comp) - inner->keys);
+    }
+
+    Leaf* findLeaf(const Key& key) const {
+        Node* n = root;
+        while (!n->isLeaf) n = asInner(n)->children[childIndex(asInner(n), key)];
+        return asLeaf(n);
+    }
+
+    // Result of inserting below a node: set when the node split and a new right sibling appeared
+    struct Split {
+        Node* right;
+        Key separator;
+    };
+
+    Split splitLeaf(Leaf* leaf) {
+        Leaf* right = new Leaf();
+        int half = leaf->count / 2;
+        right->count = leaf->count - half;
+        for (int i = 0; i < right->count; ++i) {
+            right->keys[i] = move(leaf->keys[half + i]);
+            right->values[i] = move(leaf->values[half + i]);
+        }
+        leaf->count = half;
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next) leaf->next->prev = right;
+        else tail = right;
+        leaf->next = right;
+        return Split{right, right->keys[0]};
+    }
+
+    Split splitInner(Inner* inner) {
+        Inner* right = new Inner();
+        int mid = inner->count / 2; // keys[mid] moves up to the parent
+        right->count = inner->count - mid - 1;
+        for (int i = 0; i < right->count; ++i) right->keys[i] = move(inner->keys[mid + 1 + i]);
+        for (int i = 0; i <= right->count; ++i) right->children[i] = inner->children[mid + 1 + i];
+        Key separator = move(inner->keys[mid]);
+        inner->count = mid;
+        return Split{right, separator};
+    }
+
+    // Inserts key below node; returns {leaf, index, inserted}, and fills split if node split
+    struct Position {
+        Leaf* leaf;
+        int index;
+        bool inserted;
+    };
+
+    Position insertInto(Node* node, const Key& key, const Value& value, Split& split) {
+        split.right = nullptr;
+        if (node->isLeaf) {
+            Leaf* leaf = asLeaf(node);
+            int pos = leafLowerBound(leaf, key);
+            if (pos < leaf->count && !comp(key, leaf->keys[pos])) return Position{leaf, pos, false};
+            for (int i = leaf->count; i > pos; --i) {
+                leaf->keys[i] = move(leaf->keys[i - 1]);
+                leaf->values[i] = move(leaf->values[i - 1]);
+            }
+            leaf->keys[pos] = key;
+            leaf->values[pos] = value;
+            leaf->count++;
+            ++elements;
+            if (leaf->count <= LEAF_CAP) return Position{leaf, pos, true};
+            split = splitLeaf(leaf);
+            if (pos >= leaf->count) return Position{asLeaf(split.right), pos - leaf->count, true};
+            return Position{leaf, pos, true};
+        }
+        Inner* inner = asInner(node);
+        int c = childIndex(inner, key);
+        Split childSplit;
+        Position result = insertInto(inner->children[c], key, value, childSplit);
+        if (childSplit.right) {
+            for (int i = inner->count; i > c; --i) {
+                inner->keys[i] = move(inner->keys[i - 1]);
+                inner->children[i + 1] = inner->children[i];
+            }
+            inner->keys[c] = move(childSplit.separator);
+            inner->children[c + 1] = childSplit.right;
+            inner->count++;
+            if (inner->count > INNER_CAP) split = splitInner(inner);
+        }
+        return result;
+    }
+
+    // Restore the minimum fill of parent->children[i] by borrowing from or merging with a sibling
+    void fixUnderflow(Inner* parent, int i) {
+        Node* child = parent->children[i];
+        Node* left = i > 0 ? parent->children[i - 1] : nullptr;
+        Node* right = i < parent->count ? parent->children[i + 1] : nullptr;
+
+        if (child->isLeaf) {
+            Leaf* c = asLeaf(child);
+            if (left && left->count > LEAF_MIN) {
+                Leaf* l = asLeaf(left);
+                for (int k = c->count; k > 0; --k) {
+                    c->keys[k] = move(c->keys[k - 1]);
+                    c->values[k] = move(c->values[k - 1]);
+                }
+                c->keys[0] = move(l->keys[l->count - 1]);
+                c->values[0] = move(l->values[l->count - 1]);
+                l->count--;
+                c->count++;
+                parent->keys[i - 1] = c->keys[0];
+            } else if (right && right->count > LEAF_MIN) {
+                Leaf* r = asLeaf(right);
+                c->keys[c->count] = move(r->keys[0]);
+                c->values[c->count] = move(r->values[0]);
+                c->count++;
+                for (int k = 1; k < r->count; ++k) {
+                    r->keys[k - 1] = move(r->keys[k]);
+                    r->values[k - 1] = move(r->values[k]);
+                }
+                r->count--;
+                parent->keys[i] = r->keys[0];
+            } else if (left) {
+                mergeLeaves(parent, i - 1);
+            } else if (right) {
+                mergeLeaves(parent, i);
+            }
+            return;
+        }
+
+        Inner* c = asInner(child);
+        if (left && left->count > INNER_MIN) {
+            Inner* l = asInner(left);
+            for (int k = c->count; k > 0; --k) c->keys[k] = move(c->keys[k - 1]);
+            for (int k = c->count + 1; k > 0; --k) c->children[k] = c->children[k - 1];
+            c->keys[0] = move(parent->keys[i - 1]);
+            c->children[0] = l->children[l->count];
+            parent->keys[i - 1] = move(l->keys[l->count - 1]);
+            l->count--;
+            c->count++;
+        } else if (right && right->count > INNER_MIN) {
+            Inner* r = asInner(right);
+            c->keys[c->count] = move(parent->keys[i]);
+            c->children[c->count + 1] = r->children[0];
+            c->count++;
+            parent->keys[i] = move(r->keys[0]);
+            for (int k = 1; k < r->count; ++k) r->keys[k - 1] = move(r->keys[k]);
+            for (int k = 1; k <= r->count; ++k) r->children[k - 1] = r->children[k];
+            r->count--;
+        } else if (left) {
+            mergeInner(parent, i - 1);
+        } else if (right) {
+            mergeInner(parent, i);
+        }
+    }
+
+    // Remove separator j and child j + 1 from parent after merging child j + 1 into child j
+    static void removeFromParent(Inner* parent, int j) {
+        for (int k = j; k < parent->count - 1; ++k) parent->keys[k] = move(parent->keys[k + 1]);
+        for (int k = j + 1; k < parent->count; ++k) parent->children[k] = parent->children[k + 1];
+        parent->count--;
+    }
+
+    void mergeLeaves(Inner* parent, int j) {
+        Leaf* l = asLeaf(parent->children[j]);
+        Leaf* r = asLeaf(parent->children[j + 1]);
+        for (int k = 0; k < r->count; ++k) {
+            l->keys[l->count + k] = move(r->keys[k]);
+            l->values[l->count + k] = move(r->values[k]);
+        }
+        l->count += r->count;
+        l->next = r->next;
+        if (r->next) r->next->prev = l;
+        else tail = l;
+        removeFromParent(parent, j);
+        delete r;
+    }
+
+    void mergeInner(Inner* parent, int j) {
+        Inner* l = asInner(parent->children[j]);
+        Inner* r = asInner(parent->children[j + 1]);
+        l->keys[l->count] = move(parent->keys[j]); // Separator comes down between the two halves
+        for (int k = 0; k < r->count; ++k) l->keys[l->count + 1 + k] = move(r->keys[k]);
+        for (int k = 0; k <= r->count; ++k) l->children[l->count + 1 + k] = r->children[k];
+        l->count += r->count + 1;
+        removeFromParent(parent, j);
+        delete r;
+    }
+
+    bool eraseFrom(Node* node, const Key& key) {
+        if (node->isLeaf) {
+            Leaf* leaf = asLeaf(node);
+            int pos = leafLowerBound(leaf, key);
+            if (pos == leaf->count || comp(key, leaf->keys[pos])) return false;
+            for (int k = pos + 1; k < leaf->count; ++k) {
+                leaf->keys[k - 1] = move(leaf->keys[k]);
+                leaf->values[k - 1] = move(leaf->values[k]);
+            }
+            leaf->count--;
+            --elements;
+            return true;
+        }
+        Inner* inner = asInner(node);
+        int c = childIndex(inner, key);
+        if (!eraseFrom(inner->children[c], key)) return false;
+        Node* child = inner->children[c];
+        int minimum = child->isLeaf ? LEAF_MIN : INNER_MIN;
+        if (child->count < minimum) fixUnderflow(inner, c);
+        return true;
+    }
+
+    void destroy(Node* node) {
+        if (!node->isLeaf) {
+            Inner* inner = asInner(node);
+            for (int i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+            delete inner;
+        } else {
+            delete asLeaf(node);
+        }
+    }
+
+public:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class BPlusTreeMap;
+        using TreePtr = typename conditional<Const, const BPlusTreeMap*, BPlusTreeMap*>::type;
+        using ValueRef = typename conditional<Const, const Value&, Value&>::type;
+
+        Leaf* leaf; // nullptr for end()
+        int index;
+        TreePtr tree;
+
+        Iterator(Leaf* l, int i, TreePtr t) : leaf(l), index(i), tree(t) {}
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = pair<const Key, Value>;
+        using difference_type = ptrdiff_t;
+        using reference = pair<const Key&, ValueRef>;
+
+        // it->first needs an object to point at, so operator-> returns one by value
+        struct pointer {
+            reference ref;
+            reference* operator->() { return &ref; }
+        };
+
+        Iterator() : leaf(nullptr), index(0), tree(nullptr) {}
+        operator Iterator<true>() const { return Iterator<true>(leaf, index, tree); }
+
+        reference operator*() const { return reference(leaf->keys[index], leaf->values[index]); }
+        pointer operator->() const { return pointer{**this}; }
+
+        Iterator& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator& operator--() {
+            if (!leaf) {
+                leaf = tree->tail; // --end()
+                index = leaf->count - 1;
+            } else if (index == 0) {
+                leaf = leaf->prev;
+                index = leaf->count - 1;
+            } else {
+                --index;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+        Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+
+        bool operator==(const Iterator& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    // Position of the first key not less than key, moving to the next leaf if needed
+    template <typename It, typename Tree>
+    static It lowerBoundIn(Tree* tree, const Key& key) {
+        Leaf* leaf = tree->findLeaf(key);
+        int pos = tree->leafLowerBound(leaf, key);
+        if (pos == leaf->count) return It(leaf->next, 0, tree);
+        return It(leaf, pos, tree);
+    }
+
+    template <typename It, typename Tree>
+    static It upperBoundIn(Tree* tree, const Key& key) {
+        It it = lowerBoundIn<It>(tree, key);
+        if (it.leaf && !tree->comp(key, it.leaf->keys[it.index])) ++it;
+        return it;
+    }
+
+public:
+    explicit BPlusTreeMap(const Compare& c = Compare()) : root(new Leaf()), elements(0), comp(c) {
+        head = tail = asLeaf(root);
+    }
+
+    ~BPlusTreeMap() {
+        destroy(root);
+    }
+
+    BPlusTreeMap(const BPlusTreeMap& other) : BPlusTreeMap(other.comp) {
+        for (auto p : other) insert(p.first, p.second);
+    }
+
+    BPlusTreeMap& operator=(const BPlusTreeMap& other) {
+        if (this != &other) {
+            clear();
+            for (auto p : other) insert(p.first, p.second);
+        }
+        return *this;
+    }
+
+    pair<iterator, bool> insert(const Key& key, const Value& value) {
+        Split split;
+        Position pos = insertInto(root, key, value, split);
+        if (split.right) {
+            // The root split: grow the tree by one level
+            Inner* newRoot = new Inner();
+            newRoot->keys[0] = move(split.separator);
+            newRoot->children[0] = root;
+            newRoot->children[1] = split.right;
+            newRoot->count = 1;
+            root = newRoot;
+        }
+        return {iterator(pos.leaf, pos.index, this), pos.inserted};
+    }
+
+    pair<iterator, bool> insert(const pair<Key, Value>& item) {
+        return insert(item.first, item.second);
+    }
+
+    pair<iterator, bool> emplace(const Key& key, const Value& value) {
+        return insert(key, value);
+    }
+
+    Value& operator[](const Key& key) {
+        iterator it = find(key);
+        if (it == end()) it = insert(key, Value()).first;
+        return (*it).second;
+    }
+
+    size_t erase(const Key& key) {
+        if (!eraseFrom(root, key)) return 0;
+        if (!root->isLeaf && root->count == 0) {
+            // The root lost its last separator: shrink the tree by one level
+            Inner* old = asInner(root);
+            root = old->children[0];
+            delete old;
+        }
+        return 1;
+    }
+
+    // Returns the element after the erased one
+    iterator erase(const_iterator pos) {
+        Key key = pos.leaf->keys[pos.index]; // Copy: rebalancing may move the stored key
+        erase(key);
+        return lower_bound(key);
+    }
+
+    iterator find(const Key& key) {
+        iterator it = lower_bound(key);
+        if (it.leaf && !comp(key, it.leaf->keys[it.index])) return it;
+        return end();
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        if (it.leaf && !comp(key, it.leaf->keys[it.index])) return it;
+        return end();
+    }
+
+    size_t count(const Key& key) const {
+        Leaf* leaf = findLeaf(key);
+        int pos = leafLowerBound(leaf, key);
+        if (pos < leaf->count) return comp(key, leaf->keys[pos]) ? 0 : 1;
+        return leaf->next && !comp(key, leaf->next->keys[0]) ? 1 : 0;
+    }
+
+    iterator lower_bound(const Key& key) { return lowerBoundIn<iterator>(this, key); }
+    const_iterator lower_bound(const Key& key) const { return lowerBoundIn<const_iterator>(this, key); }
+    iterator upper_bound(const Key& key) { return upperBoundIn<iterator>(this, key); }
+    const_iterator upper_bound(const Key& key) const { return upperBoundIn<const_iterator>(this, key); }
+
+    iterator begin() { return elements ? iterator(head, 0, this) : end(); }
+    iterator end() { return iterator(nullptr, 0, this); }
+    const_iterator begin() const { return elements ? const_iterator(head, 0, this) : end(); }
+    const_iterator end() const { return const_iterator(nullptr, 0, this); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_t size() const { return elements; }
+    bool empty() const { return elements == 0; }
+
+    void clear() {
+        destroy(root);
+        root = new Leaf();
+        head = tail = asLeaf(root);
+        elements = 0;
+    }
+
+    // Depth of the tree, 1 for a single leaf
+    int height() const {
+        int h = 1;
+        for (Node* n = root; !n->isLeaf; n = asInner(n)->children[0]) ++h;
+        return h;
+    }
+};
+
+template <typename Key, typename Compare = less<Key>>
+class BPlusTreeSet {
+private:
+    struct Empty {};
+    using Tree = BPlusTreeMap<Key, Empty, Compare>;
+    Tree tree;
+
+public:
+    class iterator {
+    private:
+        typename Tree::const_iterator it;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = Key;
+        using difference_type = ptrdiff_t;
+        using reference = const Key&;
+        using pointer = const Key*;
+
+        iterator() {}
+        iterator(typename Tree::const_iterator i) : it(i) {}
+
+        const Key& operator*() const { return (*it).first; }
+        const Key* operator->() const { return &(*it).first; }
+        iterator& operator++() { ++it; return *this; }
+        iterator& operator--() { --it; return *this; }
+        iterator operator++(int) { iterator old = *this; ++it; return old; }
+        iterator operator--(int) { iterator old = *this; --it; return old; }
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+    };
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    explicit BPlusTreeSet(const Compare& c = Compare()) : tree(c) {}
+
+    pair<iterator, bool> insert(const Key& key) {
+        auto result = tree.insert(key, Empty());
+        return {iterator(result.first), result.second};
+    }
+
+    pair<iterator, bool> emplace(const Key& key) { return insert(key); }
+    size_t erase(const Key& key) { return tree.erase(key); }
+
+    iterator erase(iterator pos) {
+        Key key = *pos;
+        tree.erase(key);
+        return lower_bound(key);
+    }
+
+    size_t count(const Key& key) const { return tree.count(key); }
+    iterator find(const Key& key) const { return iterator(tree.find(key)); }
+    iterator lower_bound(const Key& key) const { return iterator(tree.lower_bound(key)); }
+    iterator upper_bound(const Key& key) const { return iterator(tree.upper_bound(key)); }
+    iterator begin() const { return iterator(tree.begin()); }
+    iterator end() const { return iterator(tree.end()); }
+    reverse_iterator rbegin() const { return reverse_iterator(end()); }
+    reverse_iterator rend() const { return reverse_iterator(begin()); }
+    size_t size() const { return tree.size(); }
+    bool empty() const { return tree.empty(); }
+    void clear() { tree.clear(); }
+};
+
+// Same steps as setUsage() in example.cpp
+void bplusSetUsage() {
+    BPlusTreeSet<int> s;
+    s.insert(10);
+    s.insert(20);
+    s.insert(30);
+    s.insert(20); // Duplicate, will not be inserted
+
+    cout << "Set after insertions: ";
+    for (const auto& n : s) cout << n << " "; // Output: 10 20 30
+    cout << endl;
+    cout << "Count of 20: " << s.count(20) << endl; // Output: 1
+
+    s.erase(20);
+    cout << "Set after removing 20: ";
+    for (const auto& n : s) cout << n << " "; // Output: 10 30
+    cout << endl;
+    cout << "Size of set: " << s.size() << endl; // Output: 2
+
+    s.clear();
+    s.insert(15);
+    s.insert(25);
+    s.insert(5);
+    cout << "Lower bound of 10: " << *s.lower_bound(10) << endl; // Output: 15
+    cout << "Upper bound of 10: " << *s.upper_bound(10) << endl; // Output: 15
+
+    cout << "Set elements in reverse: ";
+    for (auto it = s.rbegin(); it != s.rend(); ++it) cout << *it << " "; // Output: 25 15 5
+    cout << endl;
+
+    s.erase(s.find(15)); // Erase through an iterator
+    cout << "Set after erasing 15 by iterator: ";
+    for (const auto& n : s) cout << n << " "; // Output: 5 25
+    cout << endl;
+}
+
+// Same steps as mapUsage() in example.cpp
+void bplusMapUsage() {
+    BPlusTreeMap<string, int> m;
+    m["Alice"] = 25;
+    m["Bob"] = 30;
+    m["Charlie"] = 35;
+
+    cout << "Map after insertions:\n";
+    for (const auto& p : m) cout << p.first << ": " << p.second << endl; // Output: All pairs
+    cout << "Age of Bob: " << m["Bob"] << endl; // Output: 30
+    cout << "Count of Alice: " << m.count("Alice") << endl; // Output: 1
+
+    m.erase("Alice");
+    cout << "Size of map: " << m.size() << endl; // Output: 2
+    m.erase(m.find("Bob")); // Erase through an iterator
+    cout << "Last entry: " << m.rbegin()->first << endl; // Output: Charlie
+    m.clear();
+
+    m["David"] = 40;
+    m["Eve"] = 45;
+    cout << "Lower bound for 'Bob': " << m.lower_bound("Bob")->first << endl; // Output: David
+    cout << "Upper bound for 'Bob': " << m.upper_bound("Bob")->first << endl; // Output: David
+}
+
+// Random inserts and erases (by key and by iterator) mirrored into std::map; returns true if both
+// always agree, including lower_bound / upper_bound probes and iteration in both directions
+bool bplusSelfCheck() {
+    BPlusTreeMap<int, int> tree;
+    map<int, int> reference;
+    mt19937 rng(5);
+    for (int step = 0; step < 200000; ++step) {
+        int key = static_cast<int>(rng() % 5000);
+        uint32_t op = rng() % 6;
+        if (op == 0) {
+            if (tree.erase(key) != reference.erase(key)) return false;
+        } else if (op == 1) {
+            auto it = tree.find(key);
+            auto expected = reference.find(key);
+            if ((it == tree.end()) != (expected == reference.end())) return false;
+            if (expected != reference.end()) {
+                auto next = tree.erase(it);
+                auto expectedNext = reference.erase(expected);
+                if ((next == tree.end()) != (expectedNext == reference.end())) return false;
+                if (expectedNext != reference.end() && next->first != expectedNext->first) return false;
+            }
+        } else {
+            tree.insert(key, step);
+            reference.insert({key, step});
+        }
+        if (step % 1000 == 0) {
+            int probe = static_cast<int>(rng() % 5000);
+            auto a = tree.lower_bound(probe);
+            auto b = reference.lower_bound(probe);
+            if ((a == tree.end()) != (b == reference.end())) return false;
+            if (b != reference.end() && (a->first != b->first || a->second != b->second)) return false;
+            auto c = tree.upper_bound(probe);
+            auto d = reference.upper_bound(probe);
+            if ((c == tree.end()) != (d == reference.end())) return false;
+            if (d != reference.end() && c->first != d->first) return false;
+            if (d != reference.begin() && (c == tree.begin() || prev(c)->first != prev(d)->first)) return false;
+        }
+    }
+    if (tree.size() != reference.size()) return false;
+    auto it = reference.begin();
+    for (auto p : tree) {
+        if (p.first != it->first || p.second != it->second) return false;
+        ++it;
+    }
+    auto rit = reference.rbegin();
+    for (auto r = tree.rbegin(); r != tree.rend(); ++r, ++rit) {
+        if (r->first != rit->first || r->second != rit->second) return false;
+    }
+    return rit == reference.rend();
+}
+
+void bplusBenchmark() {
+    const size_t n = 2000000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (auto& k : keys) k = static_cast<int>(rng());
+
+    auto time = [](auto&& f) {
+        auto start = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    map<int, int> stdMap;
+    BPlusTreeMap<int, int> tree;
+    long long sumA = 0, sumB = 0;
+
+    cout << "\n" << n << " random int keys (std::map / BPlusTreeMap, ms):\n";
+    double a = time([&]() { for (int k : keys) stdMap.insert({k, k}); });
+    double b = time([&]() { for (int k : keys) tree.insert(k, k); });
+    cout << "  insert:        " << a << " / " << b << "  (tree height " << tree.height() << ")\n";
+
+    a = time([&]() { for (int k : keys) sumA += stdMap.count(k ^ 1); });
+    b = time([&]() { for (int k : keys) sumB += tree.count(k ^ 1); });
+    cout << "  count:         " << a << " / " << b << endl;
+
+    // 100k short range scans of 100 elements starting at lower_bound
+    a = time([&]() {
+        for (size_t i = 0; i < 100000; ++i) {
+            auto it = stdMap.lower_bound(keys[i]);
+            for (int j = 0; j < 100 && it != stdMap.end(); ++j, ++it) sumA += it->second;
+        }
+    });
+    b = time([&]() {
+        for (size_t i = 0; i < 100000; ++i) {
+            auto it = tree.lower_bound(keys[i]);
+            for (int j = 0; j < 100 && it != tree.end(); ++j, ++it) sumB += it->second;
+        }
+    });
+    cout << "  range scans:   " << a << " / " << b << endl;
+
+    a = time([&]() { for (const auto& p : stdMap) sumA += p.second; });
+    b = time([&]() { for (const auto& p : tree) sumB += p.second; });
+    cout << "  full scan:     " << a << " / " << b << endl;
+
+    a = time([&]() { for (size_t i = 0; i < n; i += 2) stdMap.erase(keys[i]); });
+    b = time([&]() { for (size_t i = 0; i < n; i += 2) tree.erase(keys[i]); });
+    cout << "  erase half:    " << a << " / " << b << endl;
+    cout << "  Results agree: " << (sumA == sumB && stdMap.size() == tree.size() ? "Yes" : "No") << endl;
+}
+
+int main() {
+    cout << "Set Usage:\n";
+    bplusSetUsage();
+    cout << "\nMap Usage:\n";
+    bplusMapUsage();
+    cout << "\nRandomized check against std::map: " << (bplusSelfCheck() ? "passed" : "FAILED") << endl;
+    bplusBenchmark();
+    return 0;
+}
@@ -0,0 +1,437 @@
+#include <iostream>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Compressed Sorted-Integer Set:
+ *
+ * 1. **Problem**:
+ *    - A set<int> of IDs spends a 32-byte tree node (plus malloc's header) on every 4-byte
+ *      integer, and intersecting two of them walks millions of pointers.
+ *
+ * 2. **CompressedIntSet** (read-optimized, built once from a list of uint32_t values):
+ *    - Values are sorted and split into blocks of 128. Each block stores the differences between
+ *      consecutive values (small numbers for dense IDs), bit-packed with the fewest bits that fit
+ *      the largest difference in that block.
+ *    - Packing is "vertical" over 4 lanes: value k goes to lane k % 4, so one SSE2 shift/mask step
+ *      unpacks 4 deltas and a 4-wide prefix sum turns them back into values. A block decodes in a
+ *      few hundred instructions with no branches per value.
+ *    - A skip table keeps the first and last value of every block, so lower_bound and contains
+ *      binary-search the table and decode a single block, and intersections skip every block whose
+ *      range does not overlap the other set.
+ *    - Operations: contains, count, lower_bound, begin/end (forward iteration), for_each, size,
+ *      memory_bytes, and the static intersect / unite of two sets.
+ */
+
+class CompressedIntSet {
+private:
+    static constexpr size_t BlockSize = 128;
+    static constexpr size_t Lanes = 4;
+
+    struct BlockInfo {
+        uint32_t first;  // Smallest value in the block
+        uint32_t last;   // Largest value in the block
+        uint32_t offset; // Index of the block's first word in packed
+        uint16_t count;  // Values in the block (BlockSize except for the last block)
+        uint8_t width;   // Bits per delta
+    };
+
+    vector<BlockInfo> blocks;
+    vector<uint32_t> packed; // Word w of lane l of a block lives at offset + w * Lanes + l
+    size_t elements;
+
+    static uint32_t bitsFor(uint32_t x) {
+        return x == 0 ? 0 : 32 - __builtin_clz(x);
+    }
+
+    void appendBlock(const uint32_t* values, size_t count) {
+        uint32_t deltas[BlockSize] = {}; // Padding deltas past count are zero
+        uint32_t maxDelta = 0;
+        for (size_t i = 1; i < count; ++i) {
+            deltas[i] = values[i] - values[i - 1];
+            maxDelta = max(maxDelta, deltas[i]);
+        }
+        uint32_t width = bitsFor(maxDelta);
+        blocks.push_back({values[0], values[count - 1], static_cast<uint32_t>(packed.size()), static_cast<uint16_t>(count),
+                          static_cast<uint8_t>(width)});
+        size_t base = packed.size();
+        packed.resize(base + width * Lanes, 0);
+        for (size_t k = 0; k < BlockSize; ++k) {
+            size_t lane = k % Lanes;
+            size_t bit = (k / Lanes) * width;
+            size_t word = bit / 32;
+            size_t shift = bit % 32;
+            packed[base + word * Lanes + lane] |= deltas[k] << shift;
+            if (shift + width > 32) packed[base + (word + 1) * Lanes + lane] |= deltas[k] >> (32 - shift);
+        }
+    }
+
+    // Writes all BlockSize values of block b to out (entries past its count repeat the last value)
+    void decode(size_t b, uint32_t* out) const {
+        const BlockInfo& info = blocks[b];
+        const uint32_t width = info.width;
+        if (width == 0) {
+            fill(out, out + BlockSize, info.first);
+            return;
+        }
+        const uint32_t* words = packed.data() + info.offset;
+#ifdef __SSE2__
+        const __m128i mask = _mm_set1_epi32(width == 32 ? -1 : static_cast<int>((1u << width) - 1));
+        __m128i carry = _mm_set1_epi32(static_cast<int>(info.first));
+        for (size_t j = 0; j < BlockSize / Lanes; ++j) {
+            uint32_t bit = static_cast<uint32_t>(j) * width;
+            uint32_t word = bit / 32;
+            uint32_t shift = bit % 32;
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + word * Lanes));
+            __m128i x = _mm_srl_epi32(lo, _mm_cvtsi32_si128(static_cast<int>(shift)));
+            if (shift + width > 32) {
+                __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + (word + 1) * Lanes));
+                x = _mm_or_si128(x, _mm_sll_epi32(hi, _mm_cvtsi32_si128(static_cast<int>(32 - shift))));
+            }
+            x = _mm_and_si128(x, mask);
+            // Prefix sum of the 4 deltas, plus the last value of the previous group
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi32(x, carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j * Lanes), x);
+            carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+#else
+        const uint32_t mask = width == 32 ? ~0u : (1u << width) - 1;
+        uint32_t value = info.first;
+        for (size_t k = 0; k < BlockSize; ++k) {
+            size_t lane = k % Lanes;
+            size_t bit = (k / Lanes) * width;
+            size_t word = bit / 32;
+            size_t shift = bit % 32;
+            uint32_t x = words[word * Lanes + lane] >> shift;
+            if (shift + width > 32) x |= words[(word + 1) * Lanes + lane] << (32 - shift);
+            value += x & mask;
+            out[k] = value;
+        }
+#endif
+    }
+
+    // First block whose last value is >= x (blocks.size() if none)
+    size_t blockFor(uint32_t x) const {
+        return std::lower_bound(blocks.begin(), blocks.end(), x,
+                                [](const BlockInfo& b, uint32_t v) { return b.last < v; }) - blocks.begin();
+    }
+
+    // Skips blocks of s (starting at b) whose last value is below x
+    static size_t skipTo(const CompressedIntSet& s, size_t b, uint32_t x) {
+        if (b < s.blocks.size() && s.blocks[b].last >= x) return b;
+        return std::lower_bound(s.blocks.begin() + b, s.blocks.end(), x,
+                                [](const BlockInfo& blk, uint32_t v) { return blk.last < v; }) - s.blocks.begin();
+    }
+
+public:
+    class const_iterator {
+    private:
+        friend class CompressedIntSet;
+        const CompressedIntSet* set;
+        size_t block; // set->blocks.size() for end()
+        size_t pos;
+        uint32_t values[BlockSize];
+
+        void load() {
+            if (block < set->blocks.size()) set->decode(block, values);
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = const uint32_t&;
+
+        const_iterator() : set(nullptr), block(0), pos(0) {}
+        const_iterator(const CompressedIntSet* s, size_t b, size_t p) : set(s), block(b), pos(p) { load(); }
+
+        reference operator*() const { return values[pos]; }
+        pointer operator->() const { return &values[pos]; }
+
+        const_iterator& operator++() {
+            if (++pos == set->blocks[block].count) {
+                ++block;
+                pos = 0;
+                load();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return block == other.block && pos == other.pos; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = const_iterator;
+
+    CompressedIntSet() : elements(0) {}
+
+    // Builds the set from any values (sorted and deduplicated here)
+    template <typename Iterator>
+    CompressedIntSet(Iterator first, Iterator last) : elements(0) {
+        vector<uint32_t> values(first, last);
+        sort(values.begin(), values.end());
+        values.erase(unique(values.begin(), values.end()), values.end());
+        build(values);
+    }
+
+    // values must be sorted and free of duplicates
+    void build(const vector<uint32_t>& values) {
+        blocks.clear();
+        packed.clear();
+        elements = values.size();
+        for (size_t i = 0; i < values.size(); i += BlockSize) {
+            appendBlock(values.data() + i, min(BlockSize, values.size() - i));
+        }
+        blocks.shrink_to_fit();
+        packed.shrink_to_fit();
+    }
+
+    bool contains(uint32_t x) const {
+        size_t b = blockFor(x);
+        if (b == blocks.size() || x < blocks[b].first) return false;
+        uint32_t values[BlockSize];
+        decode(b, values);
+        return binary_search(values, values + blocks[b].count, x);
+    }
+
+    size_t count(uint32_t x) const { return contains(x) ? 1 : 0; }
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, blocks.size(), 0); }
+
+    const_iterator lower_bound(uint32_t x) const {
+        size_t b = blockFor(x);
+        const_iterator it(this, b, 0);
+        if (b < blocks.size()) it.pos = std::lower_bound(it.values, it.values + blocks[b].count, x) - it.values;
+        return it;
+    }
+
+    // Calls f(value) for every value in order; faster than iterating
+    template <typename F>
+    void for_each(F f) const {
+        uint32_t values[BlockSize];
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            decode(b, values);
+            for (size_t i = 0; i < blocks[b].count; ++i) f(values[i]);
+        }
+    }
+
+    size_t size() const { return elements; }
+    bool empty() const { return elements == 0; }
+    size_t memory_bytes() const { return blocks.size() * sizeof(BlockInfo) + packed.size() * sizeof(uint32_t); }
+
+    static CompressedIntSet intersect(const CompressedIntSet& a, const CompressedIntSet& b) {
+        vector<uint32_t> result;
+        uint32_t va[BlockSize];
+        uint32_t vb[BlockSize];
+        size_t i = 0, j = 0;
+        size_t decodedA = SIZE_MAX, decodedB = SIZE_MAX;
+        while (i < a.blocks.size() && j < b.blocks.size()) {
+            // Jump over blocks that end before the other side's current block starts
+            if (a.blocks[i].last < b.blocks[j].first) {
+                i = skipTo(a, i + 1, b.blocks[j].first);
+                continue;
+            }
+            if (b.blocks[j].last < a.blocks[i].first) {
+                j = skipTo(b, j + 1, a.blocks[i].first);
+                continue;
+            }
+            if (decodedA != i) a.decode(decodedA = i, va);
+            if (decodedB != j) b.decode(decodedB = j, vb);
+            set_intersection(va, va + a.blocks[i].count, vb, vb + b.blocks[j].count, back_inserter(result));
+            // Advance whichever block ends first; its values can't match anything further on
+            uint32_t lastA = a.blocks[i].last, lastB = b.blocks[j].last;
+            if (lastA <= lastB) ++i;
+            if (lastB <= lastA) ++j;
+        }
+        CompressedIntSet out;
+        out.build(result);
+        return out;
+    }
+
+    static CompressedIntSet unite(const CompressedIntSet& a, const CompressedIntSet& b) {
+        vector<uint32_t> result;
+        result.reserve(a.size() + b.size());
+        auto ia = a.begin(), ib = b.begin();
+        auto ea = a.end(), eb = b.end();
+        // Pre-increment only: copying an iterator copies its decoded block
+        while (ia != ea && ib != eb) {
+            uint32_t x = *ia, y = *ib;
+            result.push_back(min(x, y));
+            if (x <= y) ++ia;
+            if (y <= x) ++ib;
+        }
+        for (; ia != ea; ++ia) result.push_back(*ia);
+        for (; ib != eb; ++ib) result.push_back(*ib);
+        CompressedIntSet out;
+        out.build(result);
+        return out;
+    }
+};
+
+// Same steps as setUsage() in example.cpp (the set is built in one go, then queried)
+void compressedIntSetUsage() {
+    vector<uint32_t> ids = {10, 20, 30, 20};
+    CompressedIntSet s(ids.begin(), ids.end());
+    cout << "Set elements: ";
+    for (uint32_t x : s) cout << x << " "; // Output: 10 20 30
+    cout << endl;
+    cout << "Set contains 20? " << (s.contains(20) ? "Yes" : "No") << endl; // Output: Yes
+    cout << "First element >= 15: " << *s.lower_bound(15) << endl; // Output: 20
+
+    vector<uint32_t> other = {20, 30, 40};
+    CompressedIntSet t(other.begin(), other.end());
+    cout << "Intersection: ";
+    for (uint32_t x : CompressedIntSet::intersect(s, t)) cout << x << " "; // Output: 20 30
+    cout << endl;
+    cout << "Union size: " << CompressedIntSet::unite(s, t).size() << endl; // Output: 4
+}
+
+struct AllocationCounter {
+    static size_t bytes;
+};
+size_t AllocationCounter::bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        AllocationCounter::bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        AllocationCounter::bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Randomized comparison against set<uint32_t>, including wide gaps and single-element blocks
+bool compressedIntSetSelfCheck() {
+    mt19937 rng(17);
+    for (uint32_t spread : {2u, 300u, 70000u, 4000000000u}) {
+        vector<uint32_t> a(1000 + rng() % 3000), b(1000 + rng() % 3000);
+        for (auto& x : a) x = rng() % spread;
+        for (auto& x : b) x = rng() % spread;
+        a.push_back(0xFFFFFFFFu);
+        set<uint32_t> sa(a.begin(), a.end()), sb(b.begin(), b.end());
+        CompressedIntSet ca(a.begin(), a.end()), cb(b.begin(), b.end());
+        if (!equal(ca.begin(), ca.end(), sa.begin(), sa.end())) return false;
+        vector<uint32_t> expected;
+        set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+        CompressedIntSet both = CompressedIntSet::intersect(ca, cb);
+        if (!equal(both.begin(), both.end(), expected.begin(), expected.end())) return false;
+        expected.clear();
+        set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+        CompressedIntSet either = CompressedIntSet::unite(ca, cb);
+        if (!equal(either.begin(), either.end(), expected.begin(), expected.end())) return false;
+        for (int q = 0; q < 2000; ++q) {
+            uint32_t x = rng() % spread;
+            auto it = ca.lower_bound(x);
+            auto e = sa.lower_bound(x);
+            if ((it == ca.end()) != (e == sa.end()) || (e != sa.end() && *it != *e)) return false;
+            if (ca.contains(x) != (sa.count(x) == 1)) return false;
+        }
+    }
+    return true;
+}
+
+void compressedIntSetBenchmark() {
+    const size_t n = 2000000;
+    const uint32_t range = 1u << 27; // Average gap of 64 between IDs
+    mt19937 rng(23);
+    vector<uint32_t> a(n), b(n);
+    for (auto& x : a) x = rng() % range;
+    for (auto& x : b) x = rng() % range;
+    // b also shares a dense run of IDs with a, like two user segments that overlap
+    for (uint32_t x = 1000000; x < 1200000; ++x) {
+        a.push_back(x);
+        b.push_back(x);
+    }
+
+    using CountedSet = set<uint32_t, less<uint32_t>, CountingAllocator<uint32_t>>;
+    CountedSet sa, sb;
+    CompressedIntSet ca, cb;
+    cout << "\n~" << n << " random IDs per set (set<uint32_t> / CompressedIntSet):\n";
+    double ta = timeMs([&]() {
+        sa.insert(a.begin(), a.end());
+        sb.insert(b.begin(), b.end());
+    });
+    double tb = timeMs([&]() {
+        ca = CompressedIntSet(a.begin(), a.end());
+        cb = CompressedIntSet(b.begin(), b.end());
+    });
+    cout << "  build both:       " << ta << " / " << tb << " ms\n";
+    size_t nodeBytes = AllocationCounter::bytes / 2;
+    cout << "  bytes/element:    " << double(nodeBytes) / sa.size() << " / " << double(ca.memory_bytes()) / ca.size()
+         << " (" << double(nodeBytes) / ca.memory_bytes() << "x smaller, set excludes malloc headers)\n";
+
+    long long sumA = 0, sumB = 0;
+    ta = timeMs([&]() { for (uint32_t x : sa) sumA += x; });
+    tb = timeMs([&]() { ca.for_each([&](uint32_t x) { sumB += x; }); });
+    cout << "  full scan:        " << ta << " / " << tb << " ms\n";
+
+    vector<uint32_t> probes(1000000);
+    for (auto& p : probes) p = rng() % range;
+    ta = timeMs([&]() { for (uint32_t p : probes) sumA += sa.count(p); });
+    tb = timeMs([&]() { for (uint32_t p : probes) sumB += ca.count(p); });
+    cout << "  " << probes.size() << " lookups: " << ta << " / " << tb << " ms\n";
+
+    vector<uint32_t> expected;
+    ta = timeMs([&]() { set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected)); });
+    CompressedIntSet both;
+    tb = timeMs([&]() { both = CompressedIntSet::intersect(ca, cb); });
+    cout << "  intersection:     " << ta << " / " << tb << " ms (" << both.size() << " common)\n";
+
+    vector<uint32_t> merged;
+    ta = timeMs([&]() { set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(merged)); });
+    CompressedIntSet either;
+    tb = timeMs([&]() { either = CompressedIntSet::unite(ca, cb); });
+    cout << "  union:            " << ta << " / " << tb << " ms (" << either.size() << " total)\n";
+    bool agree = sumA == sumB && equal(both.begin(), both.end(), expected.begin(), expected.end()) && either.size() == merged.size();
+    cout << "  Results agree: " << (agree ? "Yes" : "No") << endl;
+}
+
+int main() {
+    compressedIntSetUsage();
+    cout << "Self-check against set<uint32_t>: " << (compressedIntSetSelfCheck() ? "passed" : "FAILED") << endl;
+    compressedIntSetBenchmark();
+    return 0;
+}
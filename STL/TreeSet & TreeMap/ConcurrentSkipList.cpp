@@ -0,0 +1,584 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <stdexcept>
+#include <new>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Lock-Free Concurrent Skip-List Map:
+ *
+ * 1. **Problem**:
+ *    - A map<int, int> behind a shared_mutex serializes every writer, and even readers all bounce
+ *      the same lock word between cores. With a few writing threads throughput collapses.
+ *
+ * 2. **ConcurrentSkipListMap<Key, Value, Compare>**:
+ *    - A skip list: level 0 is a sorted linked list of all elements, each higher level links a
+ *      random subset (1 in 2 of the level below), so a search skips ahead in O(log n) steps.
+ *    - Lock-free (Harris / Fraser style): every link is changed with compare-and-swap. Erase first
+ *      marks the low bit of the victim's own next pointers (logical delete, top level down to
+ *      level 0), then the node is unlinked by whichever thread walks past it.
+ *    - Operations: insert (does not overwrite, like map::insert), erase, contains, find, size,
+ *      lower_bound, upper_bound, begin/end.
+ *    - Iteration is weakly consistent: an iterator walks level 0, skipping deleted nodes. It never
+ *      crashes or repeats a key, and sees every element that was present for the whole walk, but
+ *      may or may not see elements inserted or erased while it runs.
+ *    - Values are written once at insert and never change, so readers need no synchronization
+ *      beyond the acquire load of the link that led them to the node.
+ *
+ * 3. **Epoch-based reclamation (EpochReclaimer)**:
+ *    - An erased node cannot be freed immediately: another thread may be standing on it.
+ *    - Every operation (and every live iterator) runs inside a Guard that publishes the global
+ *      epoch it started in. Unlinked nodes are retired into a per-thread bag tagged with the
+ *      current epoch; the epoch only advances once every active thread has caught up with it,
+ *      and a bag is freed two epochs later, when no thread can still see its nodes.
+ *    - Keep iterators short-lived: one that is held forever stops all reclamation.
+ */
+
+class EpochReclaimer {
+private:
+    static constexpr size_t MaxThreads = 256;
+    static constexpr unsigned ScanInterval = 64; // Retirements between attempts to advance the epoch
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+    };
+
+    struct alignas(64) Record {
+        atomic<uint64_t> epoch{0}; // (epoch << 1) | 1 while in a critical section, 0 otherwise
+        atomic<bool> inUse{false};
+        unsigned nesting = 0;
+        unsigned sinceScan = 0;
+        vector<Retired> bags[3];
+        uint64_t bagEpoch[3] = {0, 0, 0};
+    };
+
+    Record records[MaxThreads];
+    atomic<size_t> highWater{0};
+    alignas(64) atomic<uint64_t> globalEpoch{1};
+
+    struct Slot {
+        Record* record = nullptr;
+        ~Slot() {
+            if (record) record->inUse.store(false, memory_order_release); // Bags stay for the next owner
+        }
+    };
+
+    Record* local() {
+        thread_local Slot slot;
+        if (slot.record) return slot.record;
+        for (size_t i = 0; i < MaxThreads; ++i) {
+            bool expected = false;
+            if (!records[i].inUse.load(memory_order_relaxed) && records[i].inUse.compare_exchange_strong(expected, true)) {
+                size_t seen = highWater.load();
+                while (seen < i + 1 && !highWater.compare_exchange_weak(seen, i + 1)) {}
+                slot.record = &records[i];
+                return slot.record;
+            }
+        }
+        throw runtime_error("EpochReclaimer: too many threads");
+    }
+
+    static void freeBag(vector<Retired>& bag) {
+        for (const Retired& r : bag) r.deleter(r.object);
+        bag.clear();
+    }
+
+    // Advances the global epoch if every thread inside a critical section has seen the current one
+    void tryAdvance() {
+        uint64_t current = globalEpoch.load();
+        size_t n = highWater.load();
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t e = records[i].epoch.load();
+            if ((e & 1) && (e >> 1) != current) return;
+        }
+        globalEpoch.compare_exchange_strong(current, current + 1);
+    }
+
+    EpochReclaimer() = default;
+
+public:
+    static EpochReclaimer& instance() {
+        static EpochReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    ~EpochReclaimer() {
+        for (Record& r : records) {
+            for (auto& bag : r.bags) freeBag(bag);
+        }
+    }
+
+    void enter() {
+        Record* r = local();
+        if (r->nesting++ == 0) {
+            // exchange is a full barrier: the announcement is visible before we read any link
+            r->epoch.exchange((globalEpoch.load() << 1) | 1);
+        }
+    }
+
+    void leave() {
+        Record* r = local();
+        if (--r->nesting == 0) r->epoch.store(0, memory_order_release);
+    }
+
+    // Frees object once no thread can still hold a pointer to it; call only after unlinking it
+    void retire(void* object, void (*deleter)(void*)) {
+        Record* r = local();
+        uint64_t current = globalEpoch.load();
+        int index = static_cast<int>(current % 3);
+        if (r->bagEpoch[index] != current) {
+            // This bag was filled at least three epochs ago, so nobody can reach its objects
+            freeBag(r->bags[index]);
+            r->bagEpoch[index] = current;
+        }
+        r->bags[index].push_back({object, deleter});
+        if (++r->sinceScan >= ScanInterval) {
+            r->sinceScan = 0;
+            tryAdvance();
+        }
+    }
+
+    class Guard {
+    private:
+        bool active;
+
+    public:
+        Guard() : active(true) { instance().enter(); }
+        explicit Guard(bool activate) : active(activate) {
+            if (active) instance().enter();
+        }
+        Guard(const Guard& other) : Guard(other.active) {}
+        Guard& operator=(const Guard& other) {
+            if (other.active && !active) instance().enter();
+            if (!other.active && active) instance().leave();
+            active = other.active;
+            return *this;
+        }
+        ~Guard() {
+            if (active) instance().leave();
+        }
+    };
+};
+
+template <typename Key, typename Value, typename Compare = less<Key>>
+class ConcurrentSkipListMap {
+public:
+    using value_type = pair<const Key, Value>;
+
+private:
+    static constexpr int MaxLevel = 24;
+
+    // Insert and erase race to decide who retires a node: whoever finishes second does it
+    enum : uint8_t { InsertDone = 1, Unlinked = 2 };
+
+    struct Node {
+        value_type kv;
+        int height;
+        atomic<uint8_t> state;
+        atomic<uintptr_t>* next; // `height` links stored right after the node; low bit = deleted mark
+
+        Node(const Key& k, const Value& v, int h) : kv(k, v), height(h), state(0) {
+            next = reinterpret_cast<atomic<uintptr_t>*>(this + 1);
+            for (int i = 0; i < h; ++i) new (&next[i]) atomic<uintptr_t>(0);
+        }
+    };
+
+    Node* head; // Sentinel of full height; its key is never compared
+    Compare comp;
+    atomic<long long> elements;
+
+    static Node* ptr(uintptr_t word) { return reinterpret_cast<Node*>(word & ~uintptr_t(1)); }
+    static bool marked(uintptr_t word) { return word & 1; }
+    static uintptr_t word(Node* n) { return reinterpret_cast<uintptr_t>(n); }
+
+    static Node* newNode(const Key& k, const Value& v, int height) {
+        void* memory = ::operator new(sizeof(Node) + height * sizeof(atomic<uintptr_t>));
+        return new (memory) Node(k, v, height);
+    }
+
+    static void deleteNode(void* p) {
+        Node* n = static_cast<Node*>(p);
+        n->~Node();
+        ::operator delete(p);
+    }
+
+    static int randomLevel() {
+        thread_local uint64_t state = hash<thread::id>()(this_thread::get_id()) | 1;
+        state ^= state << 13; // xorshift64
+        state ^= state >> 7;
+        state ^= state << 17;
+        // Each extra level with probability 1/2
+        return 1 + __builtin_ctzll(state | (uint64_t(1) << (MaxLevel - 1)));
+    }
+
+    // Fills preds/succs with the nodes around key on every level, unlinking marked nodes on the way.
+    // Returns true if an unmarked node with an equal key is at succs[0].
+    bool search(const Key& key, Node** preds, Node** succs) {
+    retry:
+        Node* pred = head;
+        for (int level = MaxLevel - 1; level >= 0; --level) {
+            uintptr_t currWord = pred->next[level].load(memory_order_acquire);
+            if (marked(currWord)) goto retry; // pred was deleted under us
+            Node* curr = ptr(currWord);
+            while (curr) {
+                uintptr_t succWord = curr->next[level].load(memory_order_acquire);
+                while (marked(succWord)) {
+                    // curr is deleted: swing pred past it
+                    uintptr_t expected = word(curr);
+                    if (!pred->next[level].compare_exchange_strong(expected, succWord & ~uintptr_t(1), memory_order_acq_rel)) goto retry;
+                    curr = ptr(succWord);
+                    if (!curr) break;
+                    succWord = curr->next[level].load(memory_order_acquire);
+                }
+                if (!curr || !comp(curr->kv.first, key)) break;
+                pred = curr;
+                curr = ptr(succWord);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return succs[0] && !comp(key, succs[0]->kv.first);
+    }
+
+    // Read-only descent: first live node with key >= key (or > key when strict)
+    Node* seek(const Key& key, bool strict) const {
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int level = MaxLevel - 1; level >= 0; --level) {
+            curr = ptr(pred->next[level].load(memory_order_acquire));
+            while (curr && (strict ? !comp(key, curr->kv.first) : comp(curr->kv.first, key))) {
+                // Following a deleted node's link is fine: it still points forward into the list
+                pred = curr;
+                curr = ptr(curr->next[level].load(memory_order_acquire));
+            }
+        }
+        return skipDeleted(curr);
+    }
+
+    static Node* skipDeleted(Node* n) {
+        while (n) {
+            uintptr_t nextWord = n->next[0].load(memory_order_acquire);
+            if (!marked(nextWord)) return n;
+            n = ptr(nextWord);
+        }
+        return nullptr;
+    }
+
+    void finish(Node* n, uint8_t flag) {
+        if (n->state.fetch_or(flag, memory_order_acq_rel) == (InsertDone | Unlinked) - flag) {
+            EpochReclaimer::instance().retire(n, &deleteNode);
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        friend class ConcurrentSkipListMap;
+
+        EpochReclaimer::Guard guard; // Keeps the current node alive
+        Node* node;
+
+        explicit iterator(Node* n) : guard(n != nullptr), node(n) {}
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<const Key, Value>;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        iterator() : guard(false), node(nullptr) {}
+
+        reference operator*() const { return node->kv; }
+        pointer operator->() const { return &node->kv; }
+
+        iterator& operator++() {
+            node = skipDeleted(ptr(node->next[0].load(memory_order_acquire)));
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return node == other.node; }
+        bool operator!=(const iterator& other) const { return node != other.node; }
+    };
+
+    explicit ConcurrentSkipListMap(const Compare& c = Compare()) : head(newNode(Key(), Value(), MaxLevel)), comp(c), elements(0) {}
+
+    // Not safe to run concurrently with any other operation
+    ~ConcurrentSkipListMap() {
+        Node* n = head;
+        while (n) {
+            Node* next = ptr(n->next[0].load(memory_order_relaxed));
+            deleteNode(n);
+            n = next;
+        }
+    }
+
+    ConcurrentSkipListMap(const ConcurrentSkipListMap&) = delete;
+    ConcurrentSkipListMap& operator=(const ConcurrentSkipListMap&) = delete;
+
+    // Returns false (and changes nothing) if the key is already present
+    bool insert(const Key& key, const Value& value) {
+        EpochReclaimer::Guard guard;
+        Node* preds[MaxLevel];
+        Node* succs[MaxLevel];
+        Node* node = nullptr;
+        while (true) {
+            if (search(key, preds, succs)) {
+                if (node) deleteNode(node); // Never published
+                return false;
+            }
+            if (!node) node = newNode(key, value, randomLevel());
+            for (int i = 0; i < node->height; ++i) node->next[i].store(word(succs[i]), memory_order_relaxed);
+            uintptr_t expected = word(succs[0]);
+            // Linking level 0 is the moment the key becomes visible
+            if (preds[0]->next[0].compare_exchange_strong(expected, word(node), memory_order_release, memory_order_relaxed)) break;
+        }
+        elements.fetch_add(1, memory_order_relaxed);
+
+        for (int level = 1; level < node->height; ++level) {
+            while (true) {
+                uintptr_t own = node->next[level].load(memory_order_acquire);
+                if (marked(own)) goto linked; // Being erased: stop building the tower
+                if (ptr(own) != succs[level] && !node->next[level].compare_exchange_strong(own, word(succs[level]))) goto linked;
+                uintptr_t expected = word(succs[level]);
+                if (preds[level]->next[level].compare_exchange_strong(expected, word(node), memory_order_release, memory_order_relaxed)) break;
+                search(key, preds, succs);
+                if (succs[0] != node) goto linked; // Already erased and unlinked
+            }
+        }
+    linked:
+        // An eraser may have unlinked the tower before we finished it; clean up what we added since
+        if (marked(node->next[0].load(memory_order_acquire))) search(key, preds, succs);
+        finish(node, InsertDone);
+        return true;
+    }
+
+    bool erase(const Key& key) {
+        EpochReclaimer::Guard guard;
+        Node* preds[MaxLevel];
+        Node* succs[MaxLevel];
+        if (!search(key, preds, succs)) return false;
+        Node* victim = succs[0];
+        for (int level = victim->height - 1; level >= 1; --level) {
+            victim->next[level].fetch_or(1, memory_order_acq_rel);
+        }
+        uintptr_t nextWord = victim->next[0].load(memory_order_acquire);
+        while (true) {
+            if (marked(nextWord)) return false; // Another thread erased it first
+            if (victim->next[0].compare_exchange_weak(nextWord, nextWord | 1, memory_order_acq_rel)) break;
+        }
+        elements.fetch_sub(1, memory_order_relaxed);
+        search(key, preds, succs); // Unlinks the victim on every level
+        finish(victim, Unlinked);
+        return true;
+    }
+
+    bool contains(const Key& key) const {
+        EpochReclaimer::Guard guard;
+        Node* n = seek(key, false);
+        return n && !comp(key, n->kv.first);
+    }
+
+    // Copies the value out, since the node may be erased as soon as the guard is released
+    bool find(const Key& key, Value& value) const {
+        EpochReclaimer::Guard guard;
+        Node* n = seek(key, false);
+        if (!n || comp(key, n->kv.first)) return false;
+        value = n->kv.second;
+        return true;
+    }
+
+    iterator begin() const {
+        EpochReclaimer::Guard guard; // Protects the node until the iterator's own guard takes over
+        return iterator(skipDeleted(ptr(head->next[0].load(memory_order_acquire))));
+    }
+
+    iterator end() const { return iterator(); }
+
+    iterator lower_bound(const Key& key) const {
+        EpochReclaimer::Guard guard;
+        return iterator(seek(key, false));
+    }
+
+    iterator upper_bound(const Key& key) const {
+        EpochReclaimer::Guard guard;
+        return iterator(seek(key, true));
+    }
+
+    // Exact when no other thread is modifying the map
+    size_t size() const { return static_cast<size_t>(elements.load(memory_order_relaxed)); }
+    bool empty() const { return size() == 0; }
+};
+
+// Same steps as mapUsage() in example.cpp, with int keys
+void concurrentSkipListUsage() {
+    ConcurrentSkipListMap<int, string> m;
+    m.insert(30, "Bob");
+    m.insert(25, "Alice");
+    m.insert(35, "Charlie");
+    cout << "Insert existing key succeeded? " << (m.insert(25, "Eve") ? "Yes" : "No") << endl; // Output: No
+
+    cout << "Map after insertions: ";
+    for (const auto& p : m) cout << p.first << ":" << p.second << " "; // Output: 25:Alice 30:Bob 35:Charlie
+    cout << endl;
+
+    string name;
+    if (m.find(30, name)) cout << "Found key 30: " << name << endl; // Output: Bob
+    cout << "First key >= 26: " << m.lower_bound(26)->first << endl; // Output: 30
+    cout << "First key > 30: " << m.upper_bound(30)->first << endl; // Output: 35
+
+    m.erase(30);
+    cout << "Contains 30 after erase? " << (m.contains(30) ? "Yes" : "No") << endl; // Output: No
+    cout << "Size of map: " << m.size() << endl; // Output: 2
+}
+
+// Threads insert and erase overlapping keys while a reader scans; the final contents must match
+bool concurrentSkipListSelfCheck() {
+    ConcurrentSkipListMap<int, int> m;
+    const int threads = 4;
+    const int keys = 20000;
+    atomic<bool> scanOk(true);
+    atomic<bool> writersDone(false);
+    atomic<int> finishedRandom(0);
+
+    thread reader([&]() {
+        while (!writersDone.load()) {
+            int last = -1;
+            for (const auto& p : m) {
+                if (p.first <= last || p.second != p.first * 2) scanOk = false; // Sorted, no repeats
+                last = p.first;
+            }
+        }
+    });
+    vector<thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t]() {
+            mt19937 rng(t);
+            for (int round = 0; round < 100000; ++round) {
+                int key = static_cast<int>(rng() % keys);
+                if (rng() % 2) m.insert(key, key * 2);
+                else m.erase(key);
+            }
+            // Once every writer is done with random keys, leave exactly the multiples of 3
+            ++finishedRandom;
+            while (finishedRandom.load() < threads) this_thread::yield();
+            for (int key = t; key < keys; key += threads) {
+                if (key % 3 == 0) m.insert(key, key * 2);
+                else m.erase(key);
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+    writersDone = true;
+    reader.join();
+
+    size_t expected = 0;
+    auto it = m.begin();
+    for (int key = 0; key < keys; key += 3, ++expected) {
+        if (it == m.end() || it->first != key) return false;
+        ++it;
+    }
+    return scanOk && it == m.end() && m.size() == expected;
+}
+
+// Baseline: map behind a reader-writer lock
+class LockedMap {
+private:
+    map<int, int> m;
+    mutable shared_mutex lock;
+
+public:
+    bool insert(int key, int value) {
+        unique_lock<shared_mutex> guard(lock);
+        return m.emplace(key, value).second;
+    }
+
+    bool erase(int key) {
+        unique_lock<shared_mutex> guard(lock);
+        return m.erase(key) > 0;
+    }
+
+    long long scan(int from, int count) const {
+        shared_lock<shared_mutex> guard(lock);
+        long long sum = 0;
+        for (auto it = m.lower_bound(from); it != m.end() && count-- > 0; ++it) sum += it->second;
+        return sum;
+    }
+};
+
+long long skipListScan(const ConcurrentSkipListMap<int, int>& m, int from, int count) {
+    long long sum = 0;
+    for (auto it = m.lower_bound(from); it != m.end() && count-- > 0; ++it) sum += it->second;
+    return sum;
+}
+
+// Each op is a short range scan (10 elements) with probability readPercent, else an insert or erase
+template <typename Map, typename Scan>
+double benchmarkMix(Map& m, Scan scan, int threads, int readPercent, int opsPerThread, int keyRange) {
+    atomic<bool> go(false);
+    atomic<long long> checksum(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(100 + t);
+            long long local = 0;
+            while (!go.load()) {}
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = static_cast<int>(rng() % keyRange);
+                int dice = static_cast<int>(rng() % 100);
+                if (dice < readPercent) local += scan(m, key, 10);
+                else if (dice % 2) m.insert(key, key);
+                else m.erase(key);
+            }
+            checksum += local;
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    go = true;
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << ""; // Keep the loop from being optimized away
+    double seconds = chrono::duration<double>(end - start).count();
+    return threads * opsPerThread / seconds / 1e6; // Million ops per second
+}
+
+void concurrentSkipListBenchmark() {
+    const int keyRange = 1000000;
+    const int opsPerThread = 100000;
+    cout << "\nMillion ops/s (map + shared_mutex / ConcurrentSkipListMap), " << keyRange / 2 << " keys preloaded, "
+         << thread::hardware_concurrency() << " hardware threads:\n";
+    for (int readPercent : {90, 50, 10}) {
+        cout << "  " << readPercent << "% range scans, " << 100 - readPercent << "% insert/erase:\n";
+        for (int threads : {1, 2, 4, 8}) {
+            LockedMap locked;
+            ConcurrentSkipListMap<int, int> skipList;
+            for (int key = 0; key < keyRange; key += 2) {
+                locked.insert(key, key);
+                skipList.insert(key, key);
+            }
+            double a = benchmarkMix(locked, [](const LockedMap& m, int from, int count) { return m.scan(from, count); },
+                                    threads, readPercent, opsPerThread, keyRange);
+            double b = benchmarkMix(skipList, skipListScan, threads, readPercent, opsPerThread, keyRange);
+            cout << "    " << threads << " threads: " << a << " / " << b << endl;
+        }
+    }
+}
+
+int main() {
+    concurrentSkipListUsage();
+    cout << "Concurrent self-check: " << (concurrentSkipListSelfCheck() ? "passed" : "FAILED") << endl;
+    concurrentSkipListBenchmark();
+    return 0;
+}
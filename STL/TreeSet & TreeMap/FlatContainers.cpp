@@ -0,0 +1,373 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <iterator>
+
+using namespace std;
+
+/**
+ * Flat (Sorted Vector) Set and Map:
+ *
+ * 1. **Problem**:
+ *    - Every element of a set<int> or map<string, int> is its own heap node with three pointers
+ *      and a color: 32+ bytes of overhead per element, plus malloc's own header.
+ *    - For read-mostly data a sorted array does the same job with zero overhead and lookups that
+ *      touch far fewer cache lines.
+ *
+ * 2. **FlatSet<Key, Compare>** and **FlatMap<Key, Value, Compare>**:
+ *    - Elements are kept sorted in one vector (pairs for the map). As with set/map, keys cannot be
+ *      changed through an iterator: FlatSet only hands out const iterators and FlatMap's iterator
+ *      yields pair<const Key&, Value&>, since a rewritten key would break the sorted order.
+ *    - lower_bound is a branchless binary search: the loop always runs log2(n) times and the
+ *      "go left or right" choice compiles to a conditional move, so there are no mispredicted
+ *      branches to pay for.
+ *    - insert(value) is O(n) because it shifts the tail; fine for occasional updates.
+ *    - insert(first, last) is the bulk path: append the batch, sort only the batch, merge it
+ *      with the existing elements in place and drop duplicates. O(n + m log m) instead of
+ *      O(n * m). As with set/map, an existing key is never overwritten.
+ *    - Same operations as the setUsage()/mapUsage() demos: insert, emplace, count, find, erase,
+ *      lower_bound, upper_bound, operator[] (map), size, empty, clear, begin/end, rbegin/rend.
+ */
+
+// Branchless lower_bound over [first, first + n) using less(element, key)
+template <typename It, typename T, typename Less>
+It branchlessLowerBound(It first, size_t n, const T& key, Less less) {
+    if (n == 0) return first;
+    while (n > 1) {
+        size_t half = n / 2;
+        first = less(first[half], key) ? first + half : first; // Becomes a cmov
+        n -= half;
+    }
+    return first + (less(*first, key) ? 1 : 0);
+}
+
+// Shared sorted-vector core; KeyOf extracts the key from a stored element and Iterator is the
+// public iterator, built from a vector iterator
+template <typename Element, typename Key, typename KeyOf, typename Compare, typename Iterator>
+class FlatBase {
+protected:
+    vector<Element> items;
+    Compare comp;
+
+    typename vector<Element>::iterator position(const Key& key) {
+        return branchlessLowerBound(items.begin(), items.size(), key, ElementLess{comp});
+    }
+
+    struct ElementLess {
+        const Compare& comp;
+        bool operator()(const Element& e, const Key& k) const { return comp(KeyOf()(e), k); }
+    };
+
+    struct ElementOrder {
+        const Compare& comp;
+        bool operator()(const Element& a, const Element& b) const { return comp(KeyOf()(a), KeyOf()(b)); }
+    };
+
+    bool sameKey(const Element& a, const Element& b) const {
+        return !comp(KeyOf()(a), KeyOf()(b)) && !comp(KeyOf()(b), KeyOf()(a));
+    }
+
+public:
+    using iterator = Iterator;
+    using const_iterator = typename vector<Element>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    explicit FlatBase(const Compare& c = Compare()) : comp(c) {}
+
+    iterator lower_bound(const Key& key) { return iterator(position(key)); }
+
+    const_iterator lower_bound(const Key& key) const {
+        return branchlessLowerBound(items.begin(), items.size(), key, ElementLess{comp});
+    }
+
+    iterator upper_bound(const Key& key) {
+        auto it = position(key);
+        if (it != items.end() && !comp(key, KeyOf()(*it))) ++it; // Keys are unique
+        return iterator(it);
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        if (it != items.end() && !comp(key, KeyOf()(*it))) ++it;
+        return it;
+    }
+
+    iterator find(const Key& key) {
+        auto it = position(key);
+        return iterator(it != items.end() && !comp(key, KeyOf()(*it)) ? it : items.end());
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return it != items.end() && !comp(key, KeyOf()(*it)) ? it : items.end();
+    }
+
+    size_t count(const Key& key) const { return find(key) != items.end() ? 1 : 0; }
+
+    pair<iterator, bool> insert(const Element& element) {
+        auto it = position(KeyOf()(element));
+        if (it != items.end() && !comp(KeyOf()(element), KeyOf()(*it))) return {iterator(it), false};
+        return {iterator(items.insert(it, element)), true};
+    }
+
+    // Bulk insert: append, sort the batch, merge in place, drop duplicates (existing keys win)
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        size_t oldSize = items.size();
+        items.insert(items.end(), first, last);
+        auto middle = items.begin() + oldSize;
+        stable_sort(middle, items.end(), ElementOrder{comp}); // Stable: first copy in the batch wins
+        inplace_merge(items.begin(), middle, items.end(), ElementOrder{comp}); // Stable: old before new
+        auto newEnd = unique(items.begin(), items.end(),
+                             [this](const Element& a, const Element& b) { return sameKey(a, b); });
+        items.erase(newEnd, items.end());
+    }
+
+    size_t erase(const Key& key) {
+        auto it = position(key);
+        if (it == items.end() || comp(key, KeyOf()(*it))) return 0;
+        items.erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator it) { return iterator(items.erase(it)); }
+
+    iterator begin() { return iterator(items.begin()); }
+    iterator end() { return iterator(items.end()); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() { items.clear(); }
+    void reserve(size_t n) { items.reserve(n); }
+    void shrink_to_fit() { items.shrink_to_fit(); }
+
+    // Bytes held by the container (the vector's buffer)
+    size_t memory_bytes() const { return items.capacity() * sizeof(Element); }
+};
+
+struct IdentityKey {
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+};
+
+struct FirstKey {
+    template <typename P>
+    const typename P::first_type& operator()(const P& p) const { return p.first; }
+};
+
+// Keys are the whole element, so the set's iterator is the vector's const_iterator
+template <typename Key, typename Compare = less<Key>>
+class FlatSet : public FlatBase<Key, Key, IdentityKey, Compare, typename vector<Key>::const_iterator> {
+    using Base = FlatBase<Key, Key, IdentityKey, Compare, typename vector<Key>::const_iterator>;
+
+public:
+    using Base::Base;
+    using Base::insert;
+
+    pair<typename Base::iterator, bool> emplace(const Key& key) { return Base::insert(key); }
+};
+
+// FlatMap's mutable iterator: dereferences to pair<const Key&, Value&> so values can be updated in
+// place but keys cannot. Random access, like the vector iterator it wraps.
+template <typename Key, typename Value>
+class FlatMapIterator {
+    using Base = typename vector<pair<Key, Value>>::iterator;
+    Base it;
+
+public:
+    using iterator_category = random_access_iterator_tag;
+    using value_type = pair<Key, Value>;
+    using difference_type = ptrdiff_t;
+    using reference = pair<const Key&, Value&>;
+
+    struct pointer { // operator-> needs an address, so keep the proxy alive in here
+        reference ref;
+        reference* operator->() { return &ref; }
+    };
+
+    FlatMapIterator() = default;
+    explicit FlatMapIterator(Base it) : it(it) {}
+    operator typename vector<pair<Key, Value>>::const_iterator() const { return it; }
+
+    reference operator*() const { return reference(it->first, it->second); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    FlatMapIterator& operator++() { ++it; return *this; }
+    FlatMapIterator operator++(int) { return FlatMapIterator(it++); }
+    FlatMapIterator& operator--() { --it; return *this; }
+    FlatMapIterator operator--(int) { return FlatMapIterator(it--); }
+    FlatMapIterator& operator+=(difference_type n) { it += n; return *this; }
+    FlatMapIterator& operator-=(difference_type n) { it -= n; return *this; }
+    FlatMapIterator operator+(difference_type n) const { return FlatMapIterator(it + n); }
+    FlatMapIterator operator-(difference_type n) const { return FlatMapIterator(it - n); }
+    difference_type operator-(const FlatMapIterator& other) const { return it - other.it; }
+
+    bool operator==(const FlatMapIterator& other) const { return it == other.it; }
+    bool operator!=(const FlatMapIterator& other) const { return it != other.it; }
+    bool operator<(const FlatMapIterator& other) const { return it < other.it; }
+    bool operator>(const FlatMapIterator& other) const { return it > other.it; }
+    bool operator<=(const FlatMapIterator& other) const { return it <= other.it; }
+    bool operator>=(const FlatMapIterator& other) const { return it >= other.it; }
+};
+
+template <typename Key, typename Value, typename Compare = less<Key>>
+class FlatMap : public FlatBase<pair<Key, Value>, Key, FirstKey, Compare, FlatMapIterator<Key, Value>> {
+    using Base = FlatBase<pair<Key, Value>, Key, FirstKey, Compare, FlatMapIterator<Key, Value>>;
+
+public:
+    using Base::Base;
+    using Base::insert;
+
+    pair<typename Base::iterator, bool> emplace(const Key& key, const Value& value) {
+        return Base::insert(pair<Key, Value>(key, value));
+    }
+
+    Value& operator[](const Key& key) {
+        auto it = this->position(key);
+        if (it == this->items.end() || this->comp(key, it->first)) {
+            it = this->items.insert(it, pair<Key, Value>(key, Value()));
+        }
+        return it->second;
+    }
+};
+
+// Allocator that counts live bytes, used to measure how much memory set/map really use
+struct AllocationCounter {
+    static size_t bytes;
+};
+size_t AllocationCounter::bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        AllocationCounter::bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        AllocationCounter::bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+void flatUsage() {
+    FlatSet<int> s;
+    vector<int> batch = {10, 20, 30, 20};
+    s.insert(batch.begin(), batch.end()); // Bulk insert, duplicate 20 dropped
+    cout << "FlatSet after bulk insert: ";
+    for (const auto& n : s) cout << n << " "; // Output: 10 20 30
+    cout << endl;
+    cout << "Count of 20: " << s.count(20) << endl; // Output: 1
+    s.erase(20);
+    s.insert(15);
+    cout << "Lower bound of 12: " << *s.lower_bound(12) << endl; // Output: 15
+    cout << "Upper bound of 15: " << *s.upper_bound(15) << endl; // Output: 30
+
+    FlatMap<string, int> m;
+    m["Alice"] = 25;
+    m["Bob"] = 30;
+    vector<pair<string, int>> more = {{"Charlie", 35}, {"Alice", 99}}; // Alice already present
+    m.insert(more.begin(), more.end());
+    cout << "FlatMap after bulk insert:\n";
+    for (const auto& p : m) cout << p.first << ": " << p.second << endl; // Output: Alice: 25, Bob: 30, Charlie: 35
+    cout << "Lower bound for 'B': " << m.lower_bound("B")->first << endl; // Output: Bob
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void flatSetBenchmark() {
+    const size_t n = 2000000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (auto& k : keys) k = static_cast<int>(rng());
+    vector<int> probes(n);
+    for (size_t i = 0; i < n; ++i) probes[i] = (i & 1) ? keys[rng() % n] : static_cast<int>(rng()); // Half hits
+
+    using CountedSet = set<int, less<int>, CountingAllocator<int>>;
+    CountedSet nodeSet;
+    FlatSet<int> flatSet;
+    long long a = 0, b = 0;
+
+    cout << "\n" << n << " random ints (set<int> / FlatSet<int>):\n";
+    double tNode = timeMs([&]() { for (int k : keys) nodeSet.insert(k); });
+    double tFlat = timeMs([&]() { flatSet.insert(keys.begin(), keys.end()); flatSet.shrink_to_fit(); });
+    cout << "  build:          " << tNode << " ms / " << tFlat << " ms (bulk insert)\n";
+    cout << "  bytes/element:  " << double(AllocationCounter::bytes) / nodeSet.size() << " / "
+         << double(flatSet.memory_bytes()) / flatSet.size() << " (excluding malloc headers)\n";
+
+    tNode = timeMs([&]() { for (int p : probes) a += nodeSet.count(p); });
+    tFlat = timeMs([&]() { for (int p : probes) b += flatSet.count(p); });
+    cout << "  lookups:        " << n / tNode / 1e3 << " / " << n / tFlat / 1e3 << " M/s\n";
+
+    tNode = timeMs([&]() { for (int x : nodeSet) a += x; });
+    tFlat = timeMs([&]() { for (int x : flatSet) b += x; });
+    cout << "  full scan:      " << n / tNode / 1e3 << " / " << n / tFlat / 1e3 << " M/s\n";
+    cout << "  Results agree: " << (a == b ? "Yes" : "No") << endl;
+}
+
+void flatMapBenchmark() {
+    const size_t n = 500000;
+    mt19937 rng(7);
+    vector<pair<string, int>> entries(n);
+    for (size_t i = 0; i < n; ++i) entries[i] = {"user:" + to_string(rng() % 100000000), static_cast<int>(i)};
+
+    using CountedMap = map<string, int, less<string>, CountingAllocator<pair<const string, int>>>;
+    size_t before = AllocationCounter::bytes;
+    CountedMap nodeMap;
+    FlatMap<string, int> flatMap;
+    long long a = 0, b = 0;
+
+    cout << "\n" << n << " string keys (map<string,int> / FlatMap<string,int>):\n";
+    double tNode = timeMs([&]() { for (const auto& e : entries) nodeMap.insert(e); });
+    double tFlat = timeMs([&]() { flatMap.insert(entries.begin(), entries.end()); flatMap.shrink_to_fit(); });
+    cout << "  build:          " << tNode << " ms / " << tFlat << " ms (bulk insert)\n";
+    cout << "  bytes/element:  " << double(AllocationCounter::bytes - before) / nodeMap.size() << " / "
+         << double(flatMap.memory_bytes()) / flatMap.size() << " (node/array only, short strings inline)\n";
+
+    tNode = timeMs([&]() { for (const auto& e : entries) a += nodeMap.count(e.first); });
+    tFlat = timeMs([&]() { for (const auto& e : entries) b += flatMap.count(e.first); });
+    cout << "  lookups:        " << n / tNode / 1e3 << " / " << n / tFlat / 1e3 << " M/s\n";
+
+    tNode = timeMs([&]() { for (const auto& p : nodeMap) a += p.second; });
+    tFlat = timeMs([&]() { for (const auto& p : flatMap) b += p.second; });
+    cout << "  full scan:      " << n / tNode / 1e3 << " / " << n / tFlat / 1e3 << " M/s\n";
+    cout << "  Results agree: " << (a == b ? "Yes" : "No") << endl;
+}
+
+int main() {
+    flatUsage();
+    flatSetBenchmark();
+    flatMapBenchmark();
+    return 0;
+}
@@ -0,0 +1,353 @@
+#include <iostream>
+#include <set>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Order-Statistics Multiset:
+ *
+ * 1. **Problem**:
+ *    - multiset::count(x) walks every copy of x (O(log n + k)), and there is no fast way to
+ *      ask "what is the k-th smallest value?" or "how many values are below x?": both need
+ *      std::distance over the tree, which is O(n).
+ *
+ * 2. **OrderStatisticsMultiset<T, Compare, Counted>**:
+ *    - A treap (binary search tree kept balanced by random priorities) where every node also
+ *      stores the number of elements in its subtree.
+ *    - rank(x): number of elements less than x, O(log n).
+ *    - select(k): the k-th smallest element (0-based), O(log n).
+ *    - count(x): number of copies of x, O(log n) regardless of how many copies there are.
+ *    - insert(x), erase_one(x), erase(x) (removes every copy, like multiset::erase), size(),
+ *      for_each(f) in sorted order.
+ *
+ * 3. **Counted mode** (Counted = true):
+ *    - Each distinct value is stored once together with its multiplicity, so a million copies
+ *      of the same latency bucket cost one node instead of a million.
+ */
+
+template <typename T, typename Compare = less<T>, bool Counted = false>
+class OrderStatisticsMultiset {
+private:
+    struct Node {
+        T value;
+        size_t multiplicity; // Always 1 unless Counted
+        size_t size;         // Elements in this subtree, counting multiplicity
+        uint32_t priority;
+        Node* left;
+        Node* right;
+
+        Node(const T& v, uint32_t p) : value(v), multiplicity(1), size(1), priority(p), left(nullptr), right(nullptr) {}
+    };
+
+    Node* root;
+    Compare comp;
+    mt19937 rng;
+    size_t nodes;
+
+    static size_t sizeOf(Node* n) { return n ? n->size : 0; }
+
+    static void update(Node* n) {
+        n->size = n->multiplicity + sizeOf(n->left) + sizeOf(n->right);
+    }
+
+    // Split n into values < x (left) and values >= x (right); orEqual moves == x to the left too
+    void split(Node* n, const T& x, bool orEqual, Node*& left, Node*& right) {
+        if (!n) {
+            left = right = nullptr;
+            return;
+        }
+        bool goesLeft = orEqual ? !comp(x, n->value) : comp(n->value, x);
+        if (goesLeft) {
+            split(n->right, x, orEqual, n->right, right);
+            left = n;
+        } else {
+            split(n->left, x, orEqual, left, n->left);
+            right = n;
+        }
+        update(n);
+    }
+
+    // Join two treaps where every value in a is <= every value in b
+    static Node* merge(Node* a, Node* b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (a->priority > b->priority) {
+            a->right = merge(a->right, b);
+            update(a);
+            return a;
+        }
+        b->left = merge(a, b->left);
+        update(b);
+        return b;
+    }
+
+    // Counted mode: add delta to the node holding x and to every size on the path; false if absent
+    bool adjust(Node* n, const T& x, long long delta) {
+        if (!n) return false;
+        bool found;
+        if (comp(x, n->value)) {
+            found = adjust(n->left, x, delta);
+        } else if (comp(n->value, x)) {
+            found = adjust(n->right, x, delta);
+        } else {
+            n->multiplicity += delta;
+            found = true;
+        }
+        if (found) n->size += delta;
+        return found;
+    }
+
+    void destroy(Node* n) {
+        if (!n) return;
+        destroy(n->left);
+        destroy(n->right);
+        delete n;
+        --nodes;
+    }
+
+    template <typename F>
+    static void visit(Node* n, F& f) {
+        if (!n) return;
+        visit(n->left, f);
+        for (size_t i = 0; i < n->multiplicity; ++i) f(n->value);
+        visit(n->right, f);
+    }
+
+    const Node* findNode(const T& x) const {
+        Node* n = root;
+        while (n) {
+            if (comp(x, n->value)) n = n->left;
+            else if (comp(n->value, x)) n = n->right;
+            else return n;
+        }
+        return nullptr;
+    }
+
+public:
+    explicit OrderStatisticsMultiset(const Compare& c = Compare()) : root(nullptr), comp(c), rng(12345), nodes(0) {}
+
+    ~OrderStatisticsMultiset() {
+        destroy(root);
+    }
+
+    OrderStatisticsMultiset(const OrderStatisticsMultiset&) = delete;
+    OrderStatisticsMultiset& operator=(const OrderStatisticsMultiset&) = delete;
+
+    void insert(const T& x) {
+        if (Counted && adjust(root, x, 1)) return; // Existing value: bump its multiplicity
+        Node* left;
+        Node* right;
+        split(root, x, false, left, right);
+        root = merge(merge(left, new Node(x, static_cast<uint32_t>(rng()))), right);
+        ++nodes;
+    }
+
+    // Removes one copy of x; returns false if x is not present
+    bool erase_one(const T& x) {
+        if (Counted) {
+            const Node* n = findNode(x);
+            if (!n) return false;
+            if (n->multiplicity > 1) return adjust(root, x, -1);
+        }
+        Node* less;
+        Node* rest;
+        Node* equal;
+        Node* greater;
+        split(root, x, false, less, rest);
+        split(rest, x, true, equal, greater);
+        if (!equal) {
+            root = merge(less, greater);
+            return false;
+        }
+        // Every node in `equal` holds x, so dropping its root removes exactly one copy
+        Node* remaining = merge(equal->left, equal->right);
+        delete equal;
+        --nodes;
+        root = merge(merge(less, remaining), greater);
+        return true;
+    }
+
+    // Removes every copy of x, like multiset::erase(value); returns how many were removed
+    size_t erase(const T& x) {
+        Node* less;
+        Node* rest;
+        Node* equal;
+        Node* greater;
+        split(root, x, false, less, rest);
+        split(rest, x, true, equal, greater);
+        size_t removed = sizeOf(equal);
+        destroy(equal);
+        root = merge(less, greater);
+        return removed;
+    }
+
+    // Number of elements strictly less than x
+    size_t rank(const T& x) const {
+        size_t result = 0;
+        Node* n = root;
+        while (n) {
+            if (comp(n->value, x)) {
+                result += sizeOf(n->left) + n->multiplicity;
+                n = n->right;
+            } else {
+                n = n->left;
+            }
+        }
+        return result;
+    }
+
+    // The k-th smallest element, 0-based; k must be less than size()
+    const T& select(size_t k) const {
+        Node* n = root;
+        while (true) {
+            size_t leftSize = sizeOf(n->left);
+            if (k < leftSize) {
+                n = n->left;
+            } else if (k < leftSize + n->multiplicity) {
+                return n->value;
+            } else {
+                k -= leftSize + n->multiplicity;
+                n = n->right;
+            }
+        }
+    }
+
+    size_t count(const T& x) const {
+        if (Counted) {
+            const Node* n = findNode(x);
+            return n ? n->multiplicity : 0;
+        }
+        // Number of elements <= x minus number of elements < x
+        size_t upTo = 0;
+        Node* n = root;
+        while (n) {
+            if (!comp(x, n->value)) {
+                upTo += sizeOf(n->left) + n->multiplicity;
+                n = n->right;
+            } else {
+                n = n->left;
+            }
+        }
+        return upTo - rank(x);
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+        visit(root, f);
+    }
+
+    size_t size() const { return sizeOf(root); }
+    bool empty() const { return root == nullptr; }
+    size_t nodeCount() const { return nodes; } // Heap nodes in use (distinct values when Counted)
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+    }
+};
+
+// Same steps as multisetUsage() in example.cpp, plus the order-statistics queries
+void orderStatisticsUsage() {
+    OrderStatisticsMultiset<int> ms;
+    ms.insert(10);
+    ms.insert(20);
+    ms.insert(10); // Duplicate
+    ms.insert(30);
+    ms.insert(20); // Duplicate
+
+    cout << "Multiset after insertions: ";
+    ms.for_each([](int n) { cout << n << " "; }); // Output: 10 10 20 20 30
+    cout << endl;
+    cout << "Count of 10: " << ms.count(10) << endl; // Output: 2
+    cout << "Rank of 20 (elements below 20): " << ms.rank(20) << endl; // Output: 2
+    cout << "Element at index 3: " << ms.select(3) << endl; // Output: 20
+    cout << "Median: " << ms.select(ms.size() / 2) << endl; // Output: 20
+
+    ms.erase_one(20);
+    cout << "Multiset after removing one occurrence of 20: ";
+    ms.for_each([](int n) { cout << n << " "; }); // Output: 10 10 20 30
+    cout << endl;
+    cout << "Removed every 10: " << ms.erase(10) << " copies" << endl; // Output: 2 copies
+    cout << "Size of multiset: " << ms.size() << endl; // Output: 2
+
+    OrderStatisticsMultiset<int, less<int>, true> counted;
+    for (int i = 0; i < 1000; ++i) counted.insert(i % 4);
+    cout << "Counted mode: " << counted.size() << " elements in " << counted.nodeCount() << " nodes" << endl; // Output: 1000 elements in 4 nodes
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Latency-like data: values in [0, 10000) with heavy duplication
+void orderStatisticsBenchmark() {
+    const size_t n = 1000000;
+    const size_t queries = 100000;
+    mt19937 rng(9);
+    exponential_distribution<double> latency(1.0 / 800);
+    vector<int> values(n);
+    for (auto& v : values) v = min(9999, static_cast<int>(latency(rng)));
+
+    multiset<int> stdSet;
+    OrderStatisticsMultiset<int> perCopy;
+    OrderStatisticsMultiset<int, less<int>, true> counted;
+
+    cout << "\n" << n << " latency samples (multiset / per-copy treap / counted treap):\n";
+    double a = timeMs([&]() { for (int v : values) stdSet.insert(v); });
+    double b = timeMs([&]() { for (int v : values) perCopy.insert(v); });
+    double c = timeMs([&]() { for (int v : values) counted.insert(v); });
+    cout << "  insert:           " << a << " / " << b << " / " << c << " ms\n";
+    cout << "  nodes:            " << stdSet.size() << " / " << perCopy.nodeCount() << " / " << counted.nodeCount() << endl;
+
+    long long sa = 0, sb = 0, sc = 0;
+    a = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sa += stdSet.count(values[i]); });
+    b = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sb += perCopy.count(values[i]); });
+    c = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sc += counted.count(values[i]); });
+    cout << "  count x" << queries << ":     " << a << " / " << b << " / " << c << " ms\n";
+
+    // multiset needs std::distance / std::next for rank and select, so only run a few of those
+    const size_t slowQueries = 200;
+    vector<size_t> ks(queries);
+    for (auto& k : ks) k = rng() % n;
+    a = timeMs([&]() {
+        for (size_t i = 0; i < slowQueries; ++i) sa += *next(stdSet.begin(), ks[i]);
+    }) * (double(queries) / slowQueries);
+    b = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sb += perCopy.select(ks[i]); });
+    c = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sc += counted.select(ks[i]); });
+    cout << "  select x" << queries << ":    " << a << " (extrapolated) / " << b << " / " << c << " ms\n";
+
+    a = timeMs([&]() {
+        for (size_t i = 0; i < slowQueries; ++i) sa += distance(stdSet.begin(), stdSet.lower_bound(values[i]));
+    }) * (double(queries) / slowQueries);
+    b = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sb += perCopy.rank(values[i]); });
+    c = timeMs([&]() { for (size_t i = 0; i < queries; ++i) sc += counted.rank(values[i]); });
+    cout << "  rank x" << queries << ":      " << a << " (extrapolated) / " << b << " / " << c << " ms\n";
+
+    if (sa == 42) cout << ""; // Keep the multiset loops from being optimized away
+
+    bool agree = true;
+    for (size_t i = 0; i < slowQueries; ++i) {
+        size_t k = ks[i];
+        int expected = *next(stdSet.begin(), k);
+        agree = agree && perCopy.select(k) == expected && counted.select(k) == expected;
+        size_t r = distance(stdSet.begin(), stdSet.lower_bound(values[i]));
+        agree = agree && perCopy.rank(values[i]) == r && counted.rank(values[i]) == r;
+        agree = agree && perCopy.count(values[i]) == stdSet.count(values[i]);
+    }
+    cout << "  Results agree: " << (agree && sb == sc ? "Yes" : "No") << endl;
+}
+
+int main() {
+    orderStatisticsUsage();
+    orderStatisticsBenchmark();
+    return 0;
+}
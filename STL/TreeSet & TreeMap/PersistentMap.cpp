@@ -0,0 +1,492 @@
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Persistent (Immutable) Ordered Map:
+ *
+ * 1. **Problem**:
+ *    - Readers of a map<string, int> config table need a consistent view while a writer updates
+ *      it. Copying the whole map for every snapshot costs O(n) time and memory.
+ *
+ * 2. **PersistentMap<Key, Value, Compare>**:
+ *    - A B+ tree whose nodes are never modified after they are built. set() and erase() copy only
+ *      the nodes on the path from the root to the changed leaf (plus one sibling when a node has
+ *      to borrow or merge) and return a new map; every other node is shared with the old version.
+ *    - So a snapshot is just a copy of the map object (one shared_ptr): O(1). Updates are
+ *      O(log n) node copies and the old version stays valid and unchanged.
+ *    - Operations: set (insert or overwrite), erase, find (returns const Value* or nullptr),
+ *      count, lower_bound, begin/end, size, empty.
+ *    - Nodes are shared_ptrs, so a version's memory is freed when the last snapshot using it goes.
+ *
+ * 3. **PublishedMap<Key, Value, Compare>**:
+ *    - Holds the current version behind an atomic shared_ptr. Readers call snapshot() and keep a
+ *      consistent view for as long as they like; writers call update(f), which builds the next
+ *      version with f and publishes it atomically (retrying if another writer got there first).
+ */
+
+template <typename Key, typename Value, typename Compare = less<Key>>
+class PersistentMap {
+public:
+    using value_type = pair<Key, Value>;
+
+private:
+    static constexpr size_t MaxEntries = 16;  // Leaf capacity, and child capacity of inner nodes
+    static constexpr size_t MinEntries = MaxEntries / 2;
+
+    struct Node;
+    using NodePtr = shared_ptr<const Node>;
+
+    struct Node {
+        vector<value_type> entries; // Leaf: the elements, sorted
+        vector<Key> keys;           // Inner: keys[i] is the smallest key under children[i + 1]
+        vector<NodePtr> children;   // Inner only
+
+        bool leaf() const { return children.empty(); }
+        size_t fill() const { return leaf() ? entries.size() : children.size(); }
+    };
+
+    NodePtr root;
+    size_t elements;
+    Compare comp;
+
+    PersistentMap(NodePtr r, size_t n, const Compare& c) : root(move(r)), elements(n), comp(c) {}
+
+    size_t entryLowerBound(const Node* n, const Key& key) const {
+        auto it = std::lower_bound(n->entries.begin(), n->entries.end(), key,
+                                   [this](const value_type& e, const Key& k) { return comp(e.first, k); });
+        return it - n->entries.begin();
+    }
+
+    size_t childIndex(const Node* n, const Key& key) const {
+        return std::upper_bound(n->keys.begin(), n->keys.end(), key, comp) - n->keys.begin();
+    }
+
+    struct Split {
+        NodePtr right; // Set when the rebuilt node overflowed and was split in two
+        Key separator;
+    };
+
+    // Returns the rebuilt copy of n with key set to value
+    NodePtr setIn(const Node* n, const Key& key, const Value& value, Split& split, bool& added) const {
+        auto copy = make_shared<Node>(*n);
+        if (n->leaf()) {
+            size_t pos = entryLowerBound(n, key);
+            if (pos < n->entries.size() && !comp(key, n->entries[pos].first)) {
+                copy->entries[pos].second = value;
+                return copy;
+            }
+            copy->entries.insert(copy->entries.begin() + pos, value_type(key, value));
+            added = true;
+            if (copy->entries.size() > MaxEntries) {
+                auto right = make_shared<Node>();
+                right->entries.assign(copy->entries.begin() + MaxEntries / 2, copy->entries.end());
+                copy->entries.resize(MaxEntries / 2);
+                split.separator = right->entries.front().first;
+                split.right = right;
+            }
+            return copy;
+        }
+        size_t i = childIndex(n, key);
+        Split childSplit;
+        copy->children[i] = setIn(n->children[i].get(), key, value, childSplit, added);
+        if (childSplit.right) {
+            copy->keys.insert(copy->keys.begin() + i, childSplit.separator);
+            copy->children.insert(copy->children.begin() + i + 1, childSplit.right);
+            if (copy->children.size() > MaxEntries) {
+                size_t mid = copy->children.size() / 2;
+                auto right = make_shared<Node>();
+                split.separator = copy->keys[mid - 1];
+                right->keys.assign(copy->keys.begin() + mid, copy->keys.end());
+                right->children.assign(copy->children.begin() + mid, copy->children.end());
+                copy->keys.resize(mid - 1);
+                copy->children.resize(mid);
+                split.right = right;
+            }
+        }
+        return copy;
+    }
+
+    // Restores the minimum fill of child, the new parent->children[i], by borrowing from or merging
+    // with a sibling. Only parent and child (private copies) and fresh copies of siblings are modified.
+    static void rebalance(Node* parent, size_t i, shared_ptr<Node> child) {
+        if (i > 0 && parent->children[i - 1]->fill() > MinEntries) {
+            auto left = make_shared<Node>(*parent->children[i - 1]);
+            if (child->leaf()) {
+                child->entries.insert(child->entries.begin(), left->entries.back());
+                left->entries.pop_back();
+                parent->keys[i - 1] = child->entries.front().first;
+            } else {
+                child->keys.insert(child->keys.begin(), parent->keys[i - 1]);
+                child->children.insert(child->children.begin(), left->children.back());
+                parent->keys[i - 1] = left->keys.back();
+                left->keys.pop_back();
+                left->children.pop_back();
+            }
+            parent->children[i - 1] = left;
+            parent->children[i] = child;
+            return;
+        }
+        if (i + 1 < parent->children.size() && parent->children[i + 1]->fill() > MinEntries) {
+            auto right = make_shared<Node>(*parent->children[i + 1]);
+            if (child->leaf()) {
+                child->entries.push_back(right->entries.front());
+                right->entries.erase(right->entries.begin());
+                parent->keys[i] = right->entries.front().first;
+            } else {
+                child->keys.push_back(parent->keys[i]);
+                child->children.push_back(right->children.front());
+                parent->keys[i] = right->keys.front();
+                right->keys.erase(right->keys.begin());
+                right->children.erase(right->children.begin());
+            }
+            parent->children[i] = child;
+            parent->children[i + 1] = right;
+            return;
+        }
+        // Neither sibling can spare an entry: merge children[j] and children[j + 1]
+        size_t j = i > 0 ? i - 1 : i;
+        auto merged = i > 0 ? make_shared<Node>(*parent->children[j]) : child;
+        const Node* right = i > 0 ? child.get() : parent->children[j + 1].get();
+        if (merged->leaf()) {
+            merged->entries.insert(merged->entries.end(), right->entries.begin(), right->entries.end());
+        } else {
+            merged->keys.push_back(parent->keys[j]);
+            merged->keys.insert(merged->keys.end(), right->keys.begin(), right->keys.end());
+            merged->children.insert(merged->children.end(), right->children.begin(), right->children.end());
+        }
+        parent->keys.erase(parent->keys.begin() + j);
+        parent->children.erase(parent->children.begin() + j + 1);
+        parent->children[j] = merged;
+    }
+
+    // Returns the rebuilt copy of n without key, or nullptr if key is not in this subtree
+    shared_ptr<Node> eraseIn(const Node* n, const Key& key) const {
+        if (n->leaf()) {
+            size_t pos = entryLowerBound(n, key);
+            if (pos == n->entries.size() || comp(key, n->entries[pos].first)) return nullptr;
+            auto copy = make_shared<Node>(*n);
+            copy->entries.erase(copy->entries.begin() + pos);
+            return copy;
+        }
+        size_t i = childIndex(n, key);
+        shared_ptr<Node> child = eraseIn(n->children[i].get(), key);
+        if (!child) return nullptr;
+        auto copy = make_shared<Node>(*n);
+        if (child->fill() < MinEntries) rebalance(copy.get(), i, move(child));
+        else copy->children[i] = move(child);
+        return copy;
+    }
+
+public:
+    // Read-only iterator; the map (or any snapshot sharing its root) must outlive it
+    class iterator {
+    private:
+        friend class PersistentMap;
+        vector<pair<const Node*, size_t>> path; // Root to leaf, with the index taken at each level
+
+        // Descends to the leftmost leaf below path.back()'s current child
+        void descend() {
+            while (!path.back().first->leaf()) {
+                const Node* child = path.back().first->children[path.back().second].get();
+                path.push_back({child, 0});
+            }
+        }
+
+        // Moves past an exhausted leaf to the first entry of the next one (or to end())
+        void normalize() {
+            while (!path.empty() && path.back().second == path.back().first->fill()) {
+                path.pop_back();
+                if (!path.empty()) ++path.back().second;
+            }
+            if (!path.empty()) descend();
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = pair<Key, Value>;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        reference operator*() const { return path.back().first->entries[path.back().second]; }
+        pointer operator->() const { return &**this; }
+
+        iterator& operator++() {
+            ++path.back().second;
+            normalize();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            if (path.empty() || other.path.empty()) return path.empty() == other.path.empty();
+            return path.back() == other.path.back();
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    explicit PersistentMap(const Compare& c = Compare()) : root(nullptr), elements(0), comp(c) {}
+
+    // New version with key mapped to value (inserted or overwritten); this version is unchanged
+    PersistentMap set(const Key& key, const Value& value) const {
+        if (!root) {
+            auto leaf = make_shared<Node>();
+            leaf->entries.emplace_back(key, value);
+            return PersistentMap(leaf, 1, comp);
+        }
+        Split split;
+        bool added = false;
+        NodePtr newRoot = setIn(root.get(), key, value, split, added);
+        if (split.right) {
+            // The root split: grow the tree by one level
+            auto top = make_shared<Node>();
+            top->keys.push_back(split.separator);
+            top->children.push_back(newRoot);
+            top->children.push_back(split.right);
+            newRoot = top;
+        }
+        return PersistentMap(newRoot, elements + added, comp);
+    }
+
+    // New version without key; returns a copy of this version (sharing everything) if key is absent
+    PersistentMap erase(const Key& key) const {
+        if (!root) return *this;
+        shared_ptr<Node> newRoot = eraseIn(root.get(), key);
+        if (!newRoot) return *this;
+        if (!newRoot->leaf() && newRoot->children.size() == 1) return PersistentMap(newRoot->children[0], elements - 1, comp);
+        if (newRoot->leaf() && newRoot->entries.empty()) return PersistentMap(nullptr, 0, comp);
+        return PersistentMap(newRoot, elements - 1, comp);
+    }
+
+    const Value* find(const Key& key) const {
+        const Node* n = root.get();
+        if (!n) return nullptr;
+        while (!n->leaf()) n = n->children[childIndex(n, key)].get();
+        size_t pos = entryLowerBound(n, key);
+        if (pos == n->entries.size() || comp(key, n->entries[pos].first)) return nullptr;
+        return &n->entries[pos].second;
+    }
+
+    size_t count(const Key& key) const {
+        return find(key) ? 1 : 0;
+    }
+
+    iterator begin() const {
+        iterator it;
+        if (root) {
+            it.path.push_back({root.get(), 0});
+            it.descend();
+        }
+        return it;
+    }
+
+    iterator end() const { return iterator(); }
+
+    // First element whose key is >= key
+    iterator lower_bound(const Key& key) const {
+        iterator it;
+        const Node* n = root.get();
+        if (!n) return it;
+        while (!n->leaf()) {
+            size_t i = childIndex(n, key);
+            it.path.push_back({n, i});
+            n = n->children[i].get();
+        }
+        it.path.push_back({n, entryLowerBound(n, key)});
+        it.normalize();
+        return it;
+    }
+
+    size_t size() const { return elements; }
+    bool empty() const { return elements == 0; }
+};
+
+template <typename Key, typename Value, typename Compare = less<Key>>
+class PublishedMap {
+private:
+    using Map = PersistentMap<Key, Value, Compare>;
+    shared_ptr<const Map> current;
+
+public:
+    PublishedMap() : current(make_shared<const Map>()) {}
+
+    // A consistent view that later updates will not change
+    Map snapshot() const {
+        return *atomic_load(&current);
+    }
+
+    // Replaces the current version with f(current version); f may run more than once under contention
+    template <typename F>
+    void update(F f) {
+        shared_ptr<const Map> expected = atomic_load(&current);
+        while (true) {
+            auto next = make_shared<const Map>(f(*expected));
+            if (atomic_compare_exchange_weak(&current, &expected, next)) return;
+        }
+    }
+};
+
+// Same steps as mapUsage() in example.cpp; each step returns a new version
+void persistentMapUsage() {
+    PersistentMap<string, int> v0;
+    PersistentMap<string, int> v1 = v0.set("Alice", 25).set("Bob", 30).set("Charlie", 35);
+    PersistentMap<string, int> snapshot = v1; // O(1)
+    PersistentMap<string, int> v2 = v1.set("Alice", 26).erase("Bob");
+
+    cout << "Snapshot: ";
+    for (const auto& p : snapshot) cout << p.first << ":" << p.second << " "; // Output: Alice:25 Bob:30 Charlie:35
+    cout << endl;
+    cout << "Latest version: ";
+    for (const auto& p : v2) cout << p.first << ":" << p.second << " "; // Output: Alice:26 Charlie:35
+    cout << endl;
+
+    if (const int* age = v2.find("Charlie")) cout << "Found Charlie with age " << *age << endl; // Output: 35
+    cout << "Count of Bob in latest version: " << v2.count("Bob") << endl; // Output: 0
+    cout << "First key >= B in snapshot: " << snapshot.lower_bound("B")->first << endl; // Output: Bob
+    cout << "Sizes: " << v0.size() << " " << snapshot.size() << " " << v2.size() << endl; // Output: 0 3 2
+}
+
+// Randomized comparison against map<int, int>, checking that old versions never change
+bool persistentMapSelfCheck() {
+    mt19937 rng(5);
+    PersistentMap<int, int> m;
+    map<int, int> reference;
+    vector<pair<PersistentMap<int, int>, map<int, int>>> history;
+    for (int round = 0; round < 60000; ++round) {
+        int key = static_cast<int>(rng() % 3000);
+        if (rng() % 3) {
+            m = m.set(key, round);
+            reference[key] = round;
+        } else {
+            m = m.erase(key);
+            reference.erase(key);
+        }
+        if (round % 5000 == 0) history.push_back({m, reference});
+    }
+    for (const auto& version : history) {
+        if (version.first.size() != version.second.size()) return false;
+        if (!equal(version.first.begin(), version.first.end(), version.second.begin(),
+                   [](const pair<int, int>& a, const pair<const int, int>& b) { return a.first == b.first && a.second == b.second; })) {
+            return false;
+        }
+    }
+    for (int key = -1; key <= 3000; key += 7) {
+        auto it = m.lower_bound(key);
+        auto expected = reference.lower_bound(key);
+        if ((it == m.end()) != (expected == reference.end())) return false;
+        if (it != m.end() && it->first != expected->first) return false;
+    }
+    return m.size() == reference.size();
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void persistentMapBenchmark() {
+    const int n = 100000;
+    vector<string> keys;
+    for (int i = 0; i < n; ++i) keys.push_back("service." + to_string(i % 500) + ".setting." + to_string(i));
+    mt19937 rng(11);
+    shuffle(keys.begin(), keys.end(), rng);
+
+    map<string, int> table;
+    PersistentMap<string, int> persistent;
+    cout << "\n" << n << "-entry config table (map<string,int> / PersistentMap):\n";
+    double a = timeMs([&]() { for (int i = 0; i < n; ++i) table[keys[i]] = i; });
+    double b = timeMs([&]() { for (int i = 0; i < n; ++i) persistent = persistent.set(keys[i], i); });
+    cout << "  build:                " << a << " / " << b << " ms\n";
+
+    const int snapshots = 100;
+    long long checksum = 0;
+    a = timeMs([&]() {
+        for (int i = 0; i < snapshots; ++i) {
+            map<string, int> copy = table;
+            checksum += copy.size();
+        }
+    });
+    b = timeMs([&]() {
+        for (int i = 0; i < snapshots; ++i) {
+            PersistentMap<string, int> copy = persistent;
+            checksum += copy.size();
+        }
+    });
+    cout << "  " << snapshots << " snapshots:        " << a << " / " << b << " ms\n";
+
+    // Snapshot + one update, the pattern of a writer publishing every change
+    const int updates = 20000;
+    a = timeMs([&]() {
+        for (int i = 0; i < updates / 1000; ++i) {
+            map<string, int> next = table;
+            next[keys[i]] = -i;
+            checksum += next.size();
+        }
+    }) * 1000;
+    b = timeMs([&]() {
+        PersistentMap<string, int> version = persistent;
+        for (int i = 0; i < updates; ++i) version = version.set(keys[i], -i);
+        checksum += version.size();
+    });
+    cout << "  " << updates << " copy+update:  " << a << " (extrapolated) / " << b << " ms\n";
+
+    a = timeMs([&]() { for (const auto& k : keys) checksum += table.find(k)->second; });
+    b = timeMs([&]() { for (const auto& k : keys) checksum += *persistent.find(k); });
+    cout << "  " << n << " lookups:       " << a << " / " << b << " ms\n";
+
+    // One writer moves units between two accounts; readers must always see the same total
+    PublishedMap<string, int> published;
+    published.update([](const PersistentMap<string, int>& m) { return m.set("account.a", 500).set("account.b", 500); });
+    atomic<bool> done(false);
+    atomic<long long> views(0);
+    atomic<bool> consistent(true);
+    vector<thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto view = published.snapshot();
+                if (*view.find("account.a") + *view.find("account.b") != 1000) consistent = false;
+                ++views;
+            }
+        });
+    }
+    double c = timeMs([&]() {
+        for (int i = 0; i < updates; ++i) {
+            published.update([](const PersistentMap<string, int>& m) {
+                return m.set("account.a", *m.find("account.a") - 1).set("account.b", *m.find("account.b") + 1);
+            });
+        }
+    });
+    done = true;
+    for (auto& r : readers) r.join();
+    cout << "  " << updates << " published updates with 2 readers: " << c << " ms, " << views << " reader snapshots, "
+         << (consistent ? "all consistent" : "INCONSISTENT") << endl;
+    if (checksum == 42) cout << ""; // Keep the loops from being optimized away
+}
+
+int main() {
+    persistentMapUsage();
+    cout << "Self-check against map<int, int>: " << (persistentMapSelfCheck() ? "passed" : "FAILED") << endl;
+    persistentMapBenchmark();
+    return 0;
+}
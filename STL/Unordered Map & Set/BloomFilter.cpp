@@ -0,0 +1,348 @@
+#include <iostream>
+#include <iomanip>
+#include <unordered_set>
+#include <set>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <new>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Blocked Bloom Filter in Front of a Large Set:
+ *
+ * 1. **Problem**:
+ *    - us.count(40) in unorderedSetUsage() is a miss, and misses are the common case for
+ *      membership tests (deduplication, caches, join probes). On a set much larger than the
+ *      cache, every miss still walks a bucket in DRAM only to find nothing.
+ *
+ * 2. **BlockedBloomFilter**:
+ *    - A bit array split into 32-byte blocks (eight 32-bit words, never straddling a cache line).
+ *      A key picks one block with its high hash bits and sets one bit in each of the eight words,
+ *      derived from its low hash bits and eight fixed odd multipliers.
+ *    - A query touches exactly one block: with SSE2 the eight bit positions are computed four at
+ *      a time and checked with a single compare per half. One cache miss at most, usually a
+ *      hit, since the filter is a few bits per key.
+ *    - Sized from (expected keys, target false-positive rate): the constructor picks the
+ *      smallest block count whose predicted rate meets the target. About 10 bits per key gives
+ *      1%, about 16 gives 0.1%.
+ *    - No false negatives. Bits cannot be cleared, so erase is not supported on the filter itself.
+ *
+ * 3. **FilteredSet<Set>**: wraps any set (unordered_set, set, custom) and answers count/contains
+ *    from the filter when it says "definitely absent", consulting the set only otherwise.
+ *    - insert, erase, count, contains, size, empty, clear; underlying() exposes the set for
+ *      iteration.
+ *    - The filter is rebuilt from the set when the set outgrows its sizing or when erased keys
+ *      (which still read as "maybe present") reach a quarter of the sizing.
+ *    - Worth it only when most probes miss: a hit pays for the filter probe on top of the set
+ *      lookup. The benchmark below shows where the break-even lies (around half misses).
+ */
+
+// std::hash is the identity for integers: mix it so both halves of the hash are usable
+template <typename Key>
+struct FilterHash {
+    uint64_t operator()(const Key& key) const {
+        uint64_t x = hash<Key>()(key);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+class BlockedBloomFilter {
+public:
+    static constexpr size_t WordsPerBlock = 8;
+    static constexpr size_t BlockBytes = WordsPerBlock * sizeof(uint32_t);
+
+    BlockedBloomFilter(size_t expectedKeys, double falsePositiveRate)
+        : blocks(nullptr), blockCount(blocksFor(expectedKeys, falsePositiveRate)), keys(0) {
+        blocks = static_cast<uint32_t*>(::operator new(blockCount * BlockBytes, align_val_t(BlockBytes)));
+        clear();
+    }
+
+    BlockedBloomFilter(const BlockedBloomFilter& other) : blocks(nullptr), blockCount(other.blockCount), keys(other.keys) {
+        blocks = static_cast<uint32_t*>(::operator new(blockCount * BlockBytes, align_val_t(BlockBytes)));
+        memcpy(blocks, other.blocks, blockCount * BlockBytes);
+    }
+
+    BlockedBloomFilter(BlockedBloomFilter&& other) noexcept
+        : blocks(other.blocks), blockCount(other.blockCount), keys(other.keys) {
+        other.blocks = nullptr;
+        other.blockCount = other.keys = 0;
+    }
+
+    BlockedBloomFilter& operator=(BlockedBloomFilter other) noexcept {
+        swap(blocks, other.blocks);
+        swap(blockCount, other.blockCount);
+        swap(keys, other.keys);
+        return *this;
+    }
+
+    ~BlockedBloomFilter() {
+        if (blocks) ::operator delete(blocks, align_val_t(BlockBytes));
+    }
+
+    void insert(uint64_t hash) {
+        uint32_t* block = blockOf(hash);
+        uint32_t h = static_cast<uint32_t>(hash);
+        for (size_t i = 0; i < WordsPerBlock; ++i) block[i] |= 1u << ((h * Salts[i]) >> 27);
+        ++keys;
+    }
+
+    bool mayContain(uint64_t hash) const {
+        const uint32_t* block = blockOf(hash);
+        uint32_t h = static_cast<uint32_t>(hash);
+#ifdef __SSE2__
+        __m128i key = _mm_set1_epi32(static_cast<int>(h));
+        __m128i lo = bitMasks(key, _mm_load_si128(reinterpret_cast<const __m128i*>(Salts)));
+        __m128i hi = bitMasks(key, _mm_load_si128(reinterpret_cast<const __m128i*>(Salts + 4)));
+        // A bit that is wanted but missing survives andnot; the key is present if none survive
+        __m128i missingLo = _mm_andnot_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), lo);
+        __m128i missingHi = _mm_andnot_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(block + 4)), hi);
+        __m128i missing = _mm_or_si128(missingLo, missingHi);
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(missing, _mm_setzero_si128())) == 0xFFFF;
+#else
+        for (size_t i = 0; i < WordsPerBlock; ++i)
+            if (!(block[i] & (1u << ((h * Salts[i]) >> 27)))) return false;
+        return true;
+#endif
+    }
+
+    void clear() {
+        memset(blocks, 0, blockCount * BlockBytes);
+        keys = 0;
+    }
+
+    size_t memoryBytes() const { return blockCount * BlockBytes; }
+    size_t insertedKeys() const { return keys; }
+
+    // Predicted false-positive rate after n keys: block loads are Poisson(n / blocks)
+    static double predictedRate(size_t blocks, size_t n) {
+        double lambda = double(n) / blocks, spread = 12 * sqrt(lambda) + 12, rate = 0;
+        size_t first = lambda > spread ? size_t(lambda - spread) : 0, last = size_t(lambda + spread);
+        for (size_t k = first; k <= last; ++k) {
+            double p = exp(k * log(lambda) - lambda - lgamma(k + 1.0)); // Poisson pmf, in logs to avoid underflow
+            rate += p * pow(1.0 - pow(1.0 - 1.0 / 32, double(k)), double(WordsPerBlock));
+        }
+        return rate;
+    }
+
+    double predictedRate() const { return predictedRate(blockCount, keys); }
+
+private:
+    alignas(16) static constexpr uint32_t Salts[WordsPerBlock] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    uint32_t* blocks;
+    size_t blockCount;
+    size_t keys;
+
+    uint32_t* blockOf(uint64_t hash) const {
+        return blocks + ((hash >> 32) * blockCount >> 32) * WordsPerBlock; // High bits scaled to [0, blocks)
+    }
+
+#ifdef __SSE2__
+    // Per lane: 1 << ((key * salt) >> 27). SSE2 has neither a 32-bit multiply-low nor a
+    // per-lane shift, so the product is assembled from two 32x32 -> 64 multiplies and the
+    // power of two is made by writing the exponent of a float and converting it back
+    static __m128i bitMasks(__m128i key, __m128i salt) {
+        __m128i even = _mm_mul_epu32(key, salt);
+        __m128i odd = _mm_mul_epu32(_mm_srli_si128(key, 4), _mm_srli_si128(salt, 4));
+        __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                             _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        __m128i shift = _mm_srli_epi32(product, 27);
+        __m128 power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(shift, _mm_set1_epi32(127)), 23));
+        return _mm_cvttps_epi32(power); // 2^31 overflows to 0x80000000, which is exactly 1 << 31
+    }
+#endif
+
+    static size_t blocksFor(size_t expectedKeys, double falsePositiveRate) {
+        size_t n = max<size_t>(expectedKeys, 1);
+        size_t low = 1, high = 1;
+        while (predictedRate(high, n) > falsePositiveRate && high < (size_t(1) << 40)) high *= 2;
+        while (low < high) { // Smallest block count that meets the target
+            size_t mid = low + (high - low) / 2;
+            if (predictedRate(mid, n) > falsePositiveRate) low = mid + 1;
+            else high = mid;
+        }
+        return high;
+    }
+};
+
+template <typename Set, typename Hash = FilterHash<typename Set::key_type>>
+class FilteredSet {
+public:
+    using key_type = typename Set::key_type;
+
+    explicit FilteredSet(size_t expectedKeys = 1024, double falsePositiveRate = 0.01)
+        : sizing(max<size_t>(expectedKeys, 16)), rate(falsePositiveRate), erased(0), filter(sizing, rate) {}
+
+    bool insert(const key_type& key) {
+        if (!set.insert(key).second) return false;
+        if (set.size() > sizing) {
+            sizing *= 2;
+            rebuild();
+        } else {
+            filter.insert(hasher(key));
+        }
+        return true;
+    }
+
+    size_t erase(const key_type& key) {
+        size_t removed = set.erase(key);
+        if (removed && ++erased > sizing / 4) rebuild();
+        return removed;
+    }
+
+    size_t count(const key_type& key) const {
+        if (!filter.mayContain(hasher(key))) return 0; // Definite miss, answered from the filter
+        return set.count(key);
+    }
+
+    bool contains(const key_type& key) const { return count(key) != 0; }
+
+    size_t size() const { return set.size(); }
+    bool empty() const { return set.empty(); }
+
+    void clear() {
+        set.clear();
+        filter.clear();
+        erased = 0;
+    }
+
+    const Set& underlying() const { return set; }
+    const BlockedBloomFilter& bloom() const { return filter; }
+
+private:
+    Set set;
+    size_t sizing; // Key count the filter is sized for
+    double rate;
+    size_t erased; // Keys erased since the last rebuild: stale "maybe" answers
+    BlockedBloomFilter filter;
+    Hash hasher;
+
+    void rebuild() {
+        filter = BlockedBloomFilter(sizing, rate);
+        for (const auto& key : set) filter.insert(hasher(key));
+        erased = 0;
+    }
+};
+
+// Same steps as unorderedSetUsage(), on a filtered set
+void bloomFilterUsage() {
+    FilteredSet<unordered_set<int>> us(100, 0.01);
+    us.insert(10);
+    us.insert(20);
+    us.insert(10); // Duplicate (will be ignored)
+    us.insert(30);
+    cout << "Count of 10: " << us.count(10) << endl; // Output: 1
+    cout << "Count of 40: " << us.count(40) << endl; // Output: 0 (answered by the filter)
+    us.erase(20);
+    cout << "Filtered set after removing 20: ";
+    for (int n : us.underlying()) cout << n << " "; // Output: 10 30 (order may vary)
+    cout << endl;
+    cout << "Size of filtered set: " << us.size() << endl; // Output: 2
+
+    FilteredSet<set<string>> names(100, 0.001);
+    names.insert("Alice");
+    names.insert("Bob");
+    cout << "Contains Bob: " << (names.contains("Bob") ? "Yes" : "No") << endl; // Output: Yes
+    cout << "Contains Charlie: " << (names.contains("Charlie") ? "Yes" : "No") << endl; // Output: No
+    cout << "Filter size: " << names.bloom().memoryBytes() << " bytes" << endl;
+}
+
+// Random inserts, erases and lookups against a plain set, plus measured vs target false-positive rates
+bool bloomFilterSelfCheck() {
+    mt19937_64 rng(47);
+    FilteredSet<unordered_set<uint64_t>> filtered(64, 0.01); // Starts small: exercises growth rebuilds
+    unordered_set<uint64_t> expected;
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t k = rng() % 50000;
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            if (filtered.insert(k) != expected.insert(k).second) return false;
+            break;
+        case 2:
+            if (filtered.erase(k) != expected.erase(k)) return false;
+            break;
+        default:
+            if (filtered.count(k) != expected.count(k)) return false;
+        }
+    }
+    if (filtered.size() != expected.size()) return false;
+    for (uint64_t k : expected)
+        if (!filtered.contains(k)) return false; // No false negatives
+
+    cout << "\nFalse-positive rate, 1,000,000 keys, 1,000,000 absent probes:\n";
+    bool withinBounds = true;
+    for (double target : {0.1, 0.01, 0.001}) {
+        BlockedBloomFilter filter(1000000, target);
+        FilterHash<uint64_t> hasher;
+        for (uint64_t i = 0; i < 1000000; ++i) filter.insert(hasher(i));
+        size_t falsePositives = 0;
+        for (uint64_t i = 0; i < 1000000; ++i) falsePositives += filter.mayContain(hasher(1000000 + i));
+        double measured = falsePositives / 1e6;
+        withinBounds = withinBounds && measured < target * 1.2;
+        cout << "  target " << setw(5) << target << ": measured " << fixed << setprecision(4) << measured
+             << ", " << setprecision(1) << filter.memoryBytes() * 8.0 / 1000000 << " bits per key"
+             << defaultfloat << setprecision(6) << "\n";
+    }
+    return withinBounds;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void bloomFilterBenchmark() {
+    const size_t n = 8000000, lookups = 4000000;
+    mt19937_64 rng(5);
+    vector<uint64_t> keys(n);
+    for (auto& k : keys) k = rng();
+
+    unordered_set<uint64_t> plain;
+    plain.reserve(n);
+    FilteredSet<unordered_set<uint64_t>> filtered(n, 0.01);
+    for (uint64_t k : keys) {
+        plain.insert(k);
+        filtered.insert(k);
+    }
+
+    cout << "\n" << n << " keys in unordered_set<uint64_t> (far larger than cache), " << lookups
+         << " count() calls; filter " << filtered.bloom().memoryBytes() / (1 << 20) << " MB at 1%:\n";
+    cout << "  misses   unordered_set   FilteredSet   speedup\n";
+    for (double missRatio : {0.0, 0.5, 0.9, 0.99}) {
+        vector<uint64_t> probes(lookups);
+        for (auto& p : probes) p = (rng() % 10000 < missRatio * 10000) ? rng() : keys[rng() % n];
+        size_t a = 0, b = 0;
+        double plainTime = timeMs([&]() { for (uint64_t p : probes) a += plain.count(p); });
+        double filteredTime = timeMs([&]() { for (uint64_t p : probes) b += filtered.count(p); });
+        cout << fixed << setprecision(0) << setw(7) << missRatio * 100 << "%" << setprecision(1) << setw(13)
+             << plainTime << " ms" << setw(11) << filteredTime << " ms" << setprecision(2) << setw(9)
+             << plainTime / filteredTime << "x" << (a == b ? "" : "  MISMATCH") << defaultfloat << setprecision(6)
+             << "\n";
+    }
+}
+
+int main() {
+    bloomFilterUsage();
+    bool passed = bloomFilterSelfCheck();
+    cout << "Bloom filter self-check: " << (passed ? "passed" : "FAILED") << endl;
+    bloomFilterBenchmark();
+    return 0;
+}
@@ -0,0 +1,492 @@
+#include <iostream>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <type_traits>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/**
+ * Sharded Concurrent Hash Map:
+ *
+ * 1. **Problem**:
+ *    - One unordered_map<string, int> behind one mutex, shared by dozens of threads: every
+ *      lookup serializes on the lock, and the lock's cache line bounces between all cores.
+ *
+ * 2. **ConcurrentHashMap<Key, Value, Hash>**:
+ *    - The map is split into shards (64 by default) chosen by hash bits. Each shard is its own
+ *      open-addressing table with its own lock, padded to a cache line so that neighbouring shards
+ *      never share one. Writers to different shards never touch the same memory.
+ *    - Reads take no lock at all. Every shard has a sequence counter (a seqlock): writers make it
+ *      odd while they modify the shard and even again when done. A reader notes the counter,
+ *      probes the table, and retries only if the counter moved in the meantime.
+ *    - For that to be safe, a reader must be able to look at a slot while it is being rewritten,
+ *      so Key and Value must be trivially copyable (ints, structs, FixedString<N> below) and slots
+ *      are copied with relaxed atomic word loads. Tables replaced by a resize are kept until the
+ *      map is destroyed (at most as much memory again), so a reader never touches freed memory.
+ *    - Linear probing with backward-shift deletion, so erase leaves no tombstones behind.
+ *    - Operations: find (copies the value out), contains, insert (no overwrite), upsert (insert or
+ *      overwrite), compute (read-modify-write of one key under its shard lock), erase, size, and
+ *      for_each, which visits the shards in parallel.
+ *
+ * 3. **FixedString<N>**: a trivially copyable string of up to N-1 chars for string keys.
+ */
+
+template <size_t N>
+struct FixedString {
+    static_assert(N >= 2 && N <= 256, "FixedString<N> holds up to N-1 chars, N <= 256");
+    char chars[N - 1];
+    uint8_t length;
+
+    FixedString() : chars(), length(0) {}
+    FixedString(string_view s) : chars(), length(0) {
+        if (s.size() >= N) throw length_error("FixedString: key too long");
+        memcpy(chars, s.data(), s.size());
+        length = static_cast<uint8_t>(s.size());
+    }
+    FixedString(const char* s) : FixedString(string_view(s)) {}
+    FixedString(const string& s) : FixedString(string_view(s)) {}
+
+    string_view view() const { return string_view(chars, length); }
+    bool operator==(const FixedString& other) const { return view() == other.view(); }
+};
+
+template <size_t N>
+struct std::hash<FixedString<N>> {
+    size_t operator()(const FixedString<N>& s) const { return hash<string_view>()(s.view()); }
+};
+
+template <typename Key, typename Value, typename Hash = hash<Key>>
+class ConcurrentHashMap {
+private:
+    static_assert(is_trivially_copyable<Key>::value && is_trivially_copyable<Value>::value,
+                  "Lock-free readers copy slots while they may be rewritten: Key and Value must be trivially copyable");
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Slot {
+        uint64_t hash; // 0 for an empty slot (stored hashes always have the top bit set)
+        Key key;
+        Value value;
+    };
+
+    static constexpr size_t SlotWords = (sizeof(Slot) + 7) / 8;
+
+    // A slot is SlotWords 64-bit words, read and written with relaxed atomics
+    struct Table {
+        size_t mask; // Slots - 1
+        unique_ptr<uint64_t[]> words;
+
+        explicit Table(size_t slots) : mask(slots - 1), words(new uint64_t[slots * SlotWords]()) {}
+
+        uint64_t hashAt(size_t i) const { return __atomic_load_n(&words[i * SlotWords], __ATOMIC_RELAXED); }
+
+        void load(size_t i, Slot& out) const {
+            uint64_t buffer[SlotWords];
+            for (size_t w = 0; w < SlotWords; ++w) buffer[w] = __atomic_load_n(&words[i * SlotWords + w], __ATOMIC_RELAXED);
+            memcpy(&out, buffer, sizeof(Slot));
+        }
+
+        void store(size_t i, const Slot& in) {
+            uint64_t buffer[SlotWords] = {};
+            memcpy(buffer, &in, sizeof(Slot));
+            for (size_t w = 0; w < SlotWords; ++w) __atomic_store_n(&words[i * SlotWords + w], buffer[w], __ATOMIC_RELAXED);
+        }
+
+        void clearAt(size_t i) { __atomic_store_n(&words[i * SlotWords], uint64_t(0), __ATOMIC_RELAXED); }
+    };
+
+    struct alignas(CACHE_LINE) Shard {
+        mutex lock;               // Serializes writers
+        atomic<uint64_t> version; // Odd while a writer is modifying the shard
+        atomic<Table*> table;
+        size_t count;
+        vector<unique_ptr<Table>> tables; // Every table this shard has used; the last one is current
+
+        Shard() : version(0), table(nullptr), count(0) {
+            tables.emplace_back(new Table(16));
+            table.store(tables.back().get(), memory_order_relaxed);
+        }
+    };
+
+    unique_ptr<Shard[]> shards;
+    size_t shardMask;
+    Hash hasher;
+    atomic<long long> elements;
+
+    uint64_t hashOf(const Key& key) const {
+        uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return (h ^ (h >> 31)) | (uint64_t(1) << 63);
+    }
+
+    Shard& shardFor(uint64_t h) const { return shards[(h >> 40) & shardMask]; }
+
+    // Writer-side critical section: the version is odd for the duration of f
+    template <typename F>
+    static auto write(Shard& s, F f) {
+        s.version.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release); // Odd version is visible before any slot changes
+        struct Leave {
+            Shard& s;
+            ~Leave() { s.version.fetch_add(1, memory_order_release); }
+        } leave{s};
+        return f();
+    }
+
+    // Slot index of key in t, or SIZE_MAX; writers only (the shard lock is held)
+    static size_t locate(const Table* t, uint64_t h, const Key& key) {
+        Slot slot;
+        for (size_t i = h & t->mask;; i = (i + 1) & t->mask) {
+            uint64_t stored = t->hashAt(i);
+            if (stored == 0) return SIZE_MAX;
+            if (stored == h) {
+                t->load(i, slot);
+                if (slot.key == key) return i;
+            }
+        }
+    }
+
+    static void place(Table* t, const Slot& slot) {
+        size_t i = slot.hash & t->mask;
+        while (t->hashAt(i) != 0) i = (i + 1) & t->mask;
+        t->store(i, slot);
+    }
+
+    // Adds a new key; grows the shard's table at half load. Caller holds the lock inside write()
+    void addSlot(Shard& s, const Slot& slot) {
+        Table* t = s.table.load(memory_order_relaxed);
+        if ((s.count + 1) * 2 > t->mask + 1) {
+            auto bigger = make_unique<Table>((t->mask + 1) * 2);
+            Slot moved;
+            for (size_t i = 0; i <= t->mask; ++i) {
+                if (t->hashAt(i) == 0) continue;
+                t->load(i, moved);
+                place(bigger.get(), moved);
+            }
+            t = bigger.get();
+            s.tables.push_back(move(bigger)); // The old table stays readable for in-flight readers
+            s.table.store(t, memory_order_release);
+        }
+        place(t, slot);
+        ++s.count;
+        elements.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole
+    void removeAt(Shard& s, size_t hole) {
+        Table* t = s.table.load(memory_order_relaxed);
+        Slot slot;
+        for (size_t i = (hole + 1) & t->mask;; i = (i + 1) & t->mask) {
+            uint64_t h = t->hashAt(i);
+            if (h == 0) break;
+            size_t home = h & t->mask;
+            // Move i into the hole if its home position is not in (hole, i]
+            bool movable = hole <= i ? (home <= hole || home > i) : (home <= hole && home > i);
+            if (movable) {
+                t->load(i, slot);
+                t->store(hole, slot);
+                hole = i;
+            }
+        }
+        t->clearAt(hole);
+        --s.count;
+        elements.fetch_sub(1, memory_order_relaxed);
+    }
+
+public:
+    explicit ConcurrentHashMap(size_t shardCount = 64, const Hash& h = Hash()) : hasher(h), elements(0) {
+        size_t n = 1;
+        while (n < shardCount) n *= 2;
+        shards.reset(new Shard[n]);
+        shardMask = n - 1;
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // Lock-free: copies the value into out; retries if a writer changed the shard meanwhile
+    bool find(const Key& key, Value& out) const {
+        uint64_t h = hashOf(key);
+        Shard& s = shardFor(h);
+        Slot slot;
+        while (true) {
+            uint64_t before = s.version.load(memory_order_acquire);
+            if (before & 1) {
+                this_thread::yield(); // A writer is in the middle of an update
+                continue;
+            }
+            const Table* t = s.table.load(memory_order_acquire);
+            bool found = false;
+            size_t i = h & t->mask;
+            for (size_t probes = 0; probes <= t->mask; ++probes, i = (i + 1) & t->mask) {
+                uint64_t stored = t->hashAt(i);
+                if (stored == 0) break;
+                if (stored != h) continue;
+                t->load(i, slot);
+                if (slot.key == key) {
+                    found = true;
+                    break;
+                }
+            }
+            atomic_thread_fence(memory_order_acquire); // Slot reads complete before the version re-check
+            if (s.version.load(memory_order_relaxed) == before) {
+                if (found) out = slot.value;
+                return found;
+            }
+        }
+    }
+
+    bool contains(const Key& key) const {
+        Value ignored;
+        return find(key, ignored);
+    }
+
+    // Returns false (and changes nothing) if the key exists
+    bool insert(const Key& key, const Value& value) {
+        uint64_t h = hashOf(key);
+        Shard& s = shardFor(h);
+        lock_guard<mutex> guard(s.lock);
+        if (locate(s.table.load(memory_order_relaxed), h, key) != SIZE_MAX) return false;
+        write(s, [&]() { addSlot(s, Slot{h, key, value}); });
+        return true;
+    }
+
+    // Inserts or overwrites; returns true if the key was new
+    bool upsert(const Key& key, const Value& value) {
+        return compute(key, [&](Value& v, bool) { v = value; }).second;
+    }
+
+    // Calls f(value, existed) under the shard lock with the current value (or Value() if absent)
+    // and stores the result. Returns the new value and whether the key was inserted.
+    template <typename F>
+    pair<Value, bool> compute(const Key& key, F f) {
+        uint64_t h = hashOf(key);
+        Shard& s = shardFor(h);
+        lock_guard<mutex> guard(s.lock);
+        Table* t = s.table.load(memory_order_relaxed);
+        size_t i = locate(t, h, key);
+        Slot slot{h, key, Value()};
+        if (i != SIZE_MAX) t->load(i, slot);
+        f(slot.value, i != SIZE_MAX);
+        write(s, [&]() {
+            if (i != SIZE_MAX) t->store(i, slot);
+            else addSlot(s, slot);
+        });
+        return {slot.value, i == SIZE_MAX};
+    }
+
+    bool erase(const Key& key) {
+        uint64_t h = hashOf(key);
+        Shard& s = shardFor(h);
+        lock_guard<mutex> guard(s.lock);
+        size_t i = locate(s.table.load(memory_order_relaxed), h, key);
+        if (i == SIZE_MAX) return false;
+        write(s, [&]() { removeAt(s, i); });
+        return true;
+    }
+
+    // Calls f(key, value) for every element, visiting shards from `threads` threads at once.
+    // Each shard is visited under its lock, so f sees a consistent view of that shard.
+    template <typename F>
+    void for_each(F f, unsigned threads = thread::hardware_concurrency()) const {
+        size_t shardCount = shardMask + 1;
+        threads = max(1u, min<unsigned>(threads, static_cast<unsigned>(shardCount)));
+        auto visit = [&](size_t first) {
+            Slot slot;
+            for (size_t k = first; k < shardCount; k += threads) {
+                Shard& s = shards[k];
+                lock_guard<mutex> guard(s.lock);
+                const Table* t = s.table.load(memory_order_relaxed);
+                for (size_t i = 0; i <= t->mask; ++i) {
+                    if (t->hashAt(i) == 0) continue;
+                    t->load(i, slot);
+                    f(slot.key, slot.value);
+                }
+            }
+        };
+        vector<thread> workers;
+        for (unsigned w = 1; w < threads; ++w) workers.emplace_back(visit, w);
+        visit(0);
+        for (auto& w : workers) w.join();
+    }
+
+    // Exact when no writer is running
+    size_t size() const { return static_cast<size_t>(elements.load(memory_order_relaxed)); }
+    bool empty() const { return size() == 0; }
+};
+
+// Same steps as unorderedMapUsage() in example.cpp, plus the concurrent operations
+void concurrentHashMapUsage() {
+    using Name = FixedString<24>;
+    ConcurrentHashMap<Name, int> um;
+    um.insert("Alice", 25);
+    um.insert("Bob", 30);
+    um.insert("Alice", 35); // Duplicate key (ignored, as with unordered_map::insert)
+    um.insert("Charlie", 40);
+
+    int age = 0;
+    if (um.find("Alice", age)) cout << "Alice: " << age << endl; // Output: 25
+    um.upsert("Alice", 35);
+    um.find("Alice", age);
+    cout << "Alice after upsert: " << age << endl; // Output: 35
+    cout << "Contains Bob? " << (um.contains("Bob") ? "Yes" : "No") << endl; // Output: Yes
+
+    um.erase("Bob");
+    cout << "Size after removing Bob: " << um.size() << endl; // Output: 2
+
+    // Four threads count words into the same map
+    ConcurrentHashMap<Name, int> counts;
+    vector<thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&counts]() {
+            for (int i = 0; i < 1000; ++i) counts.compute(i % 2 ? "odd" : "even", [](int& n, bool) { ++n; });
+        });
+    }
+    for (auto& w : workers) w.join();
+    atomic<int> total(0);
+    counts.for_each([&](const Name& word, int n) {
+        (void)word;
+        total += n;
+    });
+    counts.find("odd", age);
+    cout << "odd: " << age << ", total: " << total << endl; // Output: odd: 2000, total: 4000
+}
+
+// Readers check that a value always matches its key while writers keep rewriting and resizing
+bool concurrentHashMapSelfCheck() {
+    ConcurrentHashMap<uint64_t, uint64_t> m(8);
+    atomic<bool> done(false);
+    atomic<bool> consistent(true);
+    vector<thread> threads;
+    for (int r = 0; r < 2; ++r) {
+        threads.emplace_back([&, r]() {
+            mt19937 rng(r);
+            uint64_t value;
+            while (!done.load()) {
+                uint64_t key = rng() % 20000;
+                if (m.find(key, value) && value % 20000 != key) consistent = false;
+            }
+        });
+    }
+    vector<thread> writers;
+    for (int w = 0; w < 3; ++w) {
+        writers.emplace_back([&, w]() {
+            mt19937 rng(100 + w);
+            for (int i = 0; i < 200000; ++i) {
+                uint64_t key = rng() % 20000;
+                if (rng() % 3) m.upsert(key, key + 20000 * (rng() % 1000));
+                else m.erase(key);
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+    done = true;
+    for (auto& t : threads) t.join();
+    size_t visited = 0;
+    m.for_each([&](uint64_t key, uint64_t value) {
+        if (value % 20000 != key) consistent = false;
+        ++visited; // for_each with one thread below, so no race
+    }, 1);
+    return consistent && visited == m.size();
+}
+
+// Baseline: the single-mutex map this replaces
+class LockedStringMap {
+private:
+    unordered_map<string, int> m;
+    mutable mutex lock;
+
+public:
+    bool find(const string& key, int& out) const {
+        lock_guard<mutex> guard(lock);
+        auto it = m.find(key);
+        if (it == m.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    void upsert(const string& key, int value) {
+        lock_guard<mutex> guard(lock);
+        m[key] = value;
+    }
+
+    void erase(const string& key) {
+        lock_guard<mutex> guard(lock);
+        m.erase(key);
+    }
+};
+
+template <typename Map, typename KeyType>
+double benchmarkMix(Map& m, const vector<KeyType>& keys, int threads, int readPercent, int opsPerThread) {
+    atomic<bool> go(false);
+    atomic<long long> checksum(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(7 + t);
+            long long local = 0;
+            int value = 0;
+            while (!go.load()) this_thread::yield();
+            for (int i = 0; i < opsPerThread; ++i) {
+                const KeyType& key = keys[rng() % keys.size()];
+                int dice = static_cast<int>(rng() % 100);
+                if (dice < readPercent) local += m.find(key, value) ? value : 0;
+                else if (dice % 4) m.upsert(key, i);
+                else m.erase(key);
+            }
+            checksum += local;
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    go = true;
+    for (auto& w : workers) w.join();
+    auto end = chrono::steady_clock::now();
+    if (checksum == 42) cout << ""; // Keep the loop from being optimized away
+    return threads * opsPerThread / chrono::duration<double>(end - start).count() / 1e6;
+}
+
+void concurrentHashMapBenchmark() {
+    using Name = FixedString<24>;
+    const int keyCount = 100000;
+    const int opsPerThread = 100000;
+    vector<string> keys;
+    vector<Name> fixedKeys;
+    for (int i = 0; i < keyCount; ++i) {
+        keys.push_back("session-" + to_string(1000000 + i * 7919));
+        fixedKeys.push_back(keys.back());
+    }
+    cout << "\nMillion ops/s (unordered_map<string,int> + mutex / ConcurrentHashMap<FixedString<24>,int>), "
+         << thread::hardware_concurrency() << " hardware threads:\n";
+    for (int readPercent : {99, 90, 50}) {
+        cout << "  " << readPercent << "% reads:\n";
+        for (int threads : {1, 4, 16, 32}) {
+            LockedStringMap locked;
+            ConcurrentHashMap<Name, int> sharded;
+            for (int i = 0; i < keyCount; i += 2) {
+                locked.upsert(keys[i], i);
+                sharded.upsert(fixedKeys[i], i);
+            }
+            double a = benchmarkMix(locked, keys, threads, readPercent, opsPerThread);
+            double b = benchmarkMix(sharded, fixedKeys, threads, readPercent, opsPerThread);
+            cout << "    " << threads << " threads: " << a << " / " << b << endl;
+        }
+    }
+}
+
+int main() {
+    concurrentHashMapUsage();
+    cout << "Concurrent self-check: " << (concurrentHashMapSelfCheck() ? "passed" : "FAILED") << endl;
+    concurrentHashMapBenchmark();
+    return 0;
+}
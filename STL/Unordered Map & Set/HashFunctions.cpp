@@ -0,0 +1,624 @@
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX512DQ__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Fast Hash Functions for Unordered Containers:
+ *
+ * 1. **Problem**:
+ *    - std::hash<string> in libstdc++ is a Murmur2 variant that is fine for long keys but slow
+ *      to get going on the short keys hash tables mostly see.
+ *    - std::hash<integer> is the identity. libstdc++ hides that with prime bucket counts, but any
+ *      power-of-two table (open addressing, SwissTable, sharded maps) takes the low bits
+ *      directly, and patterned IDs (multiples of 4096, timestamps, pointer values) then land in a
+ *      handful of buckets.
+ *
+ * 2. **Hash functors** (drop-in Hash parameters: unordered_map<string, int, WyHash>):
+ *    - WyHash: wyhash-style. Reads 8 bytes at a time and folds each pair of words with one
+ *      64x64 -> 128-bit multiply. Very short keys take a single multiply.
+ *    - Xxh3Hash: xxh3-style. Dedicated paths for 0-3, 4-8, 9-16, 17-128 and 129-240 bytes; longer
+ *      keys run eight independent 64-bit accumulators over a 192-byte secret, two lanes per SSE2
+ *      instruction, which makes it the fastest choice for long keys.
+ *    - Both take string_view (declare is_transparent) and an optional seed. They follow the
+ *      structure of the published algorithms but are not bit-compatible with them, and assume a
+ *      little-endian machine.
+ *    - IntegerHash: a strong 64-bit finalizer (two multiply-xorshift rounds), so every input bit
+ *      affects every output bit, low bits included.
+ *
+ * 3. **Batch hashing**: hashBatch(hasher, keys, n, out) hashes an array of keys; other hashers
+ *    fall back to a plain loop. IntegerHash over 64-bit keys is vectorized:
+ *    - built with AVX-512DQ (-mavx512dq, or -march=native where available): eight keys per
+ *      instruction with native 64-bit multiplies, about 3x faster than one key at a time. GCC
+ *      may vectorize a plain loop the same way at -O2 -march=native; hashBatch makes it certain.
+ *    - plain SSE2: two keys per register, each 64-bit multiply built from three 32-bit ones.
+ *      That only breaks even with the scalar loop; it exists so the batch API is the same on
+ *      every build.
+ *
+ * 4. **Quality checks** printed by main: bucket spread in a power-of-two table (empty-bucket
+ *    fraction, chi-squared ratio, longest bucket) and the avalanche bias (how far from 50% an
+ *    output bit's flip probability gets when one input bit flips).
+ */
+
+namespace hashdetail {
+
+inline uint64_t read64(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read32(const char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// 64x64 -> 128-bit product, returned as its two halves
+inline void multiply128(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    lo = static_cast<uint64_t>(r);
+    hi = static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t aLo = a & 0xffffffff, aHi = a >> 32, bLo = b & 0xffffffff, bHi = b >> 32;
+    uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    lo = (mid << 32) | (ll & 0xffffffff);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+inline uint64_t foldedMultiply(uint64_t a, uint64_t b) {
+    uint64_t lo, hi;
+    multiply128(a, b, lo, hi);
+    return lo ^ hi;
+}
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+} // namespace hashdetail
+
+struct WyHash {
+    using is_transparent = void;
+    uint64_t seed = 0;
+
+    static constexpr uint64_t S0 = 0xa0761d6478bd642fULL, S1 = 0xe7037ed1a0b428dbULL;
+    static constexpr uint64_t S2 = 0x8ebc6af09c88c6e3ULL, S3 = 0x589965cc75374cc3ULL;
+
+    size_t operator()(string_view key) const {
+        using namespace hashdetail;
+        const char* p = key.data();
+        size_t len = key.size();
+        uint64_t h = seed ^ foldedMultiply(seed ^ S0, S1);
+        uint64_t a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                size_t shift = (len >> 3) << 2; // 0 for 4-7 bytes, 4 for 8-16: the reads overlap
+                a = (read32(p) << 32) | read32(p + shift);
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - shift);
+            } else if (len > 0) {
+                const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+                a = (uint64_t(u[0]) << 16) | (uint64_t(u[len >> 1]) << 8) | u[len - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t h1 = h, h2 = h; // Three independent chains per 48 bytes
+                do {
+                    h = foldedMultiply(read64(p) ^ S1, read64(p + 8) ^ h);
+                    h1 = foldedMultiply(read64(p + 16) ^ S2, read64(p + 24) ^ h1);
+                    h2 = foldedMultiply(read64(p + 32) ^ S3, read64(p + 40) ^ h2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                h ^= h1 ^ h2;
+            }
+            while (i > 16) {
+                h = foldedMultiply(read64(p) ^ S1, read64(p + 8) ^ h);
+                p += 16;
+                i -= 16;
+            }
+            a = read64(p + i - 16); // Last 16 bytes, overlapping what was already consumed
+            b = read64(p + i - 8);
+        }
+        uint64_t lo, hi;
+        multiply128(a ^ S1, b ^ h, lo, hi);
+        return foldedMultiply(lo ^ S0 ^ len, hi ^ S1);
+    }
+};
+
+struct Xxh3Hash {
+    using is_transparent = void;
+    uint64_t seed = 0;
+
+    static constexpr size_t SecretSize = 192;
+    static constexpr size_t StripeLen = 64;
+    static constexpr size_t StripesPerBlock = (SecretSize - StripeLen) / 8;
+    static constexpr uint64_t P32_1 = 0x9E3779B1U, P32_2 = 0x85EBCA77U, P32_3 = 0xC2B2AE3DU;
+    static constexpr uint64_t P64_1 = 0x9E3779B185EBCA87ULL, P64_2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t P64_3 = 0x165667B19E3779F9ULL, P64_4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t P64_5 = 0x27D4EB2F165667C5ULL;
+
+    size_t operator()(string_view key) const {
+        using namespace hashdetail;
+        const char* p = key.data();
+        size_t len = key.size();
+        const char* s = secret();
+        if (len <= 16) {
+            if (len > 8) {
+                uint64_t lo = read64(p) ^ (read64(s + 24) + seed);
+                uint64_t hi = read64(p + len - 8) ^ (read64(s + 32) - seed);
+                return avalanche(len + __builtin_bswap64(lo) + hi + foldedMultiply(lo, hi));
+            }
+            if (len >= 4) {
+                uint64_t input = read32(p + len - 4) + (read32(p) << 32);
+                uint64_t keyed = input ^ ((read64(s + 8) ^ read64(s + 16)) - seed);
+                return rrmxmx(keyed, len);
+            }
+            if (len > 0) {
+                const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+                uint64_t combined = (uint64_t(u[0]) << 16) | (uint64_t(u[len >> 1]) << 24) | u[len - 1] | (len << 8);
+                return avalanche(combined ^ ((read32(s) ^ read32(s + 4)) + seed));
+            }
+            return avalanche(seed ^ read64(s + 56) ^ read64(s + 64));
+        }
+        if (len <= 128) {
+            uint64_t acc = len * P64_1;
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) {
+                        acc += mix16(p + 48, s + 96);
+                        acc += mix16(p + len - 64, s + 112);
+                    }
+                    acc += mix16(p + 32, s + 64);
+                    acc += mix16(p + len - 48, s + 80);
+                }
+                acc += mix16(p + 16, s + 32);
+                acc += mix16(p + len - 32, s + 48);
+            }
+            acc += mix16(p, s);
+            acc += mix16(p + len - 16, s + 16);
+            return avalanche(acc);
+        }
+        if (len <= 240) {
+            uint64_t acc = len * P64_1;
+            for (size_t i = 0; i < 8; ++i) acc += mix16(p + 16 * i, s + 16 * i);
+            acc = avalanche(acc);
+            for (size_t i = 8; i < len / 16; ++i) acc += mix16(p + 16 * i, s + 16 * (i - 8) + 3);
+            acc += mix16(p + len - 16, s + 119);
+            return avalanche(acc);
+        }
+        return hashLong(p, len);
+    }
+
+private:
+    // Shared 192-byte key material, filled from a fixed splitmix64 stream
+    static const char* secret() {
+        static const auto bytes = []() {
+            array<char, SecretSize> b{};
+            uint64_t x = 0x3c6ef372fe94f82bULL;
+            for (size_t i = 0; i < SecretSize; i += 8) {
+                uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                z ^= z >> 31;
+                memcpy(b.data() + i, &z, 8);
+            }
+            return b;
+        }();
+        return bytes.data();
+    }
+
+    static uint64_t avalanche(uint64_t h) {
+        h ^= h >> 37;
+        h *= 0x165667919E3779F9ULL;
+        return h ^ (h >> 32);
+    }
+
+    static uint64_t rrmxmx(uint64_t h, uint64_t len) {
+        h ^= hashdetail::rotl(h, 49) ^ hashdetail::rotl(h, 24);
+        h *= 0x9FB21C651E98DF25ULL;
+        h ^= (h >> 35) + len;
+        h *= 0x9FB21C651E98DF25ULL;
+        return h ^ (h >> 28);
+    }
+
+    uint64_t mix16(const char* p, const char* s) const {
+        using namespace hashdetail;
+        return foldedMultiply(read64(p) ^ (read64(s) + seed), read64(p + 8) ^ (read64(s + 8) - seed));
+    }
+
+    // One 64-byte stripe into the eight accumulators: acc[i] += lo32(d^k) * hi32(d^k), acc[i^1] += d
+    static void accumulate(uint64_t* acc, const char* p, const char* s) {
+#ifdef __SSE2__
+        for (size_t i = 0; i < 8; i += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8 * i));
+            __m128i dk = _mm_xor_si128(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 8 * i)));
+            __m128i product = _mm_mul_epu32(dk, _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+            a = _mm_add_epi64(a, _mm_add_epi64(product, swapped));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+        }
+#else
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t d = hashdetail::read64(p + 8 * i);
+            uint64_t dk = d ^ hashdetail::read64(s + 8 * i);
+            acc[i ^ 1] += d;
+            acc[i] += (dk & 0xffffffff) * (dk >> 32);
+        }
+#endif
+    }
+
+    static void scramble(uint64_t* acc, const char* s) {
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t a = acc[i] ^ (acc[i] >> 47);
+            acc[i] = (a ^ hashdetail::read64(s + 8 * i)) * P32_1;
+        }
+    }
+
+    uint64_t hashLong(const char* p, size_t len) const {
+        // A seed is folded into a private copy of the secret, as xxh3 does
+        char custom[SecretSize];
+        const char* s = secret();
+        if (seed != 0) {
+            for (size_t i = 0; i < SecretSize; i += 16) {
+                uint64_t lo = hashdetail::read64(s + i) + seed, hi = hashdetail::read64(s + i + 8) - seed;
+                memcpy(custom + i, &lo, 8);
+                memcpy(custom + i + 8, &hi, 8);
+            }
+            s = custom;
+        }
+
+        alignas(16) uint64_t acc[8] = {P32_3, P64_1, P64_2, P64_3, P64_4, P32_2, P64_5, P32_1};
+        const size_t blockLen = StripeLen * StripesPerBlock;
+        size_t blocks = (len - 1) / blockLen;
+        for (size_t b = 0; b < blocks; ++b) {
+            for (size_t n = 0; n < StripesPerBlock; ++n) accumulate(acc, p + b * blockLen + n * StripeLen, s + 8 * n);
+            scramble(acc, s + SecretSize - StripeLen);
+        }
+        size_t stripes = ((len - 1) - blockLen * blocks) / StripeLen;
+        for (size_t n = 0; n < stripes; ++n) accumulate(acc, p + blocks * blockLen + n * StripeLen, s + 8 * n);
+        accumulate(acc, p + len - StripeLen, s + SecretSize - StripeLen - 7); // Last, possibly overlapping, stripe
+
+        uint64_t result = len * P64_1;
+        for (size_t i = 0; i < 4; ++i)
+            result += hashdetail::foldedMultiply(acc[2 * i] ^ hashdetail::read64(s + 11 + 16 * i),
+                                                 acc[2 * i + 1] ^ hashdetail::read64(s + 19 + 16 * i));
+        return avalanche(result);
+    }
+};
+
+struct IntegerHash {
+    static constexpr uint64_t M1 = 0xbf58476d1ce4e5b9ULL, M2 = 0x94d049bb133111ebULL;
+
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * M1;
+        x = (x ^ (x >> 27)) * M2;
+        return x ^ (x >> 31);
+    }
+
+    template <typename Int, typename = enable_if_t<is_integral_v<Int> || is_enum_v<Int>>>
+    size_t operator()(Int x) const { return mix(static_cast<uint64_t>(x)); }
+};
+
+// Hashes keys[0..n) into out[0..n)
+template <typename Hash, typename Key>
+void hashBatch(const Hash& hasher, const Key* keys, size_t n, uint64_t* out) {
+    for (size_t i = 0; i < n; ++i) out[i] = hasher(keys[i]);
+}
+
+#if defined(__AVX512DQ__)
+inline void hashBatch(const IntegerHash&, const uint64_t* keys, size_t n, uint64_t* out) {
+    const __m512i m1 = _mm512_set1_epi64(static_cast<long long>(IntegerHash::M1));
+    const __m512i m2 = _mm512_set1_epi64(static_cast<long long>(IntegerHash::M2));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(keys + i);
+        x = _mm512_mullo_epi64(_mm512_xor_si512(x, _mm512_maskz_srli_epi64(0xff, x, 30)), m1);
+        x = _mm512_mullo_epi64(_mm512_xor_si512(x, _mm512_maskz_srli_epi64(0xff, x, 27)), m2);
+        _mm512_storeu_si512(out + i, _mm512_xor_si512(x, _mm512_maskz_srli_epi64(0xff, x, 31)));
+    }
+    for (; i < n; ++i) out[i] = IntegerHash::mix(keys[i]);
+}
+#elif defined(__SSE2__)
+namespace hashdetail {
+
+// Low 64 bits of a 64x64 product in each lane, from three 32x32 -> 64 multiplies
+inline __m128i multiplyLow64(__m128i a, __m128i b) {
+    __m128i lo = _mm_mul_epu32(a, b);
+    __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+inline __m128i mixLanes(__m128i x, __m128i m1, __m128i m2) {
+    x = multiplyLow64(_mm_xor_si128(x, _mm_srli_epi64(x, 30)), m1);
+    x = multiplyLow64(_mm_xor_si128(x, _mm_srli_epi64(x, 27)), m2);
+    return _mm_xor_si128(x, _mm_srli_epi64(x, 31));
+}
+
+} // namespace hashdetail
+
+// Two keys per register, two registers per step so the multiplies overlap
+inline void hashBatch(const IntegerHash&, const uint64_t* keys, size_t n, uint64_t* out) {
+    const __m128i m1 = _mm_set1_epi64x(static_cast<long long>(IntegerHash::M1));
+    const __m128i m2 = _mm_set1_epi64x(static_cast<long long>(IntegerHash::M2));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i + 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), hashdetail::mixLanes(a, m1, m2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 2), hashdetail::mixLanes(b, m1, m2));
+    }
+    for (; i < n; ++i) out[i] = IntegerHash::mix(keys[i]);
+}
+#endif
+
+// Same steps as unorderedMapUsage(), with the hash functions plugged in
+void hashFunctionsUsage() {
+    unordered_map<string, int, WyHash> ages;
+    ages["Alice"] = 25;
+    ages.insert({"Bob", 30});
+    ages.emplace("Charlie", 40);
+    cout << "Count of Alice: " << ages.count("Alice") << endl; // Output: 1
+    cout << "Bob's age: " << ages.find("Bob")->second << endl; // Output: 30
+    ages.erase("Charlie");
+    cout << "Size of unordered map: " << ages.size() << endl; // Output: 2
+
+    unordered_map<uint64_t, string, IntegerHash> users;
+    users[4096] = "Alice";
+    users[8192] = "Bob";
+    cout << "User 8192: " << users[8192] << endl; // Output: Bob
+
+    Xxh3Hash h1, h2{42};
+    cout << "Seeds change the hash: " << (h1("Alice") != h2("Alice") ? "Yes" : "No") << endl; // Output: Yes
+    uint64_t ids[] = {1, 2, 3, 4, 5}, hashes[5];
+    hashBatch(IntegerHash(), ids, 5, hashes);
+    cout << "Batch matches scalar: " << (hashes[4] == IntegerHash()(uint64_t(5)) ? "Yes" : "No") << endl; // Output: Yes
+}
+
+// Every length up to a few blocks, seeded and unseeded, plus SIMD batch against the scalar mixer
+bool hashFunctionsSelfCheck() {
+    mt19937_64 rng(46);
+    string buffer(5000, '\0');
+    for (auto& c : buffer) c = static_cast<char>(rng());
+    for (uint64_t seed : {uint64_t(0), uint64_t(12345)}) {
+        WyHash wy{seed};
+        Xxh3Hash xx{seed};
+        unordered_map<uint64_t, size_t> seenWy, seenXx;
+        for (size_t len = 0; len <= 2100; ++len) {
+            string_view prefix(buffer.data(), len);
+            // Prefixes of one buffer differ only in length and tail: every hash must still differ
+            if (!seenWy.emplace(wy(prefix), len).second) return false;
+            if (!seenXx.emplace(xx(prefix), len).second) return false;
+            string copy(prefix); // Depends only on the bytes, not on where they live
+            if (wy(copy) != wy(prefix) || xx(copy) != xx(prefix)) return false;
+        }
+    }
+    if (WyHash{1}("Alice") == WyHash{2}("Alice") || Xxh3Hash{1}(buffer) == Xxh3Hash{2}(buffer)) return false;
+
+    vector<uint64_t> keys(1003), batch(1003);
+    for (auto& k : keys) k = rng();
+    hashBatch(IntegerHash(), keys.data(), keys.size(), batch.data());
+    for (size_t i = 0; i < keys.size(); ++i)
+        if (batch[i] != IntegerHash::mix(keys[i])) return false;
+
+    unordered_map<string, int, Xxh3Hash> custom;
+    unordered_map<string, int> standard;
+    for (int i = 0; i < 20000; ++i) {
+        string k = "user-" + to_string(rng() % 5000);
+        if (rng() % 3 == 0) {
+            if (custom.erase(k) != standard.erase(k)) return false;
+        } else {
+            custom[k] += i;
+            standard[k] += i;
+        }
+    }
+    if (custom.size() != standard.size()) return false;
+    for (auto& [k, v] : standard)
+        if (custom.count(k) == 0 || custom[k] != v) return false;
+    return true;
+}
+
+// Spread of hashes over a power-of-two table indexed by the low bits
+template <typename Hash, typename Key>
+void reportDistribution(const string& label, const Hash& hasher, const vector<Key>& keys) {
+    size_t buckets = 1;
+    while (buckets < keys.size()) buckets <<= 1;
+    vector<size_t> load(buckets, 0);
+    for (auto& k : keys) ++load[static_cast<uint64_t>(hasher(k)) & (buckets - 1)];
+    double expected = double(keys.size()) / buckets, chi = 0;
+    size_t empty = 0, longest = 0;
+    for (size_t c : load) {
+        chi += (c - expected) * (c - expected) / expected;
+        empty += c == 0;
+        longest = max(longest, c);
+    }
+    cout << "  " << left << setw(38) << label << right << fixed << setprecision(1) << setw(6)
+         << 100.0 * empty / buckets << "%   " << setprecision(2) << setw(10) << chi / buckets << "   " << setw(6)
+         << longest << defaultfloat << setprecision(6) << "\n";
+}
+
+// Worst and mean |P(output bit flips) - 0.5| * 2 over all (input bit, output bit) pairs
+template <typename Hash, typename MakeInput, typename FlipBit>
+void reportAvalanche(const string& label, const Hash& hasher, size_t inputBits, MakeInput makeInput, FlipBit flipBit) {
+    const size_t trials = 4000;
+    vector<uint32_t> flips(inputBits * 64, 0);
+    for (size_t t = 0; t < trials; ++t) {
+        auto input = makeInput();
+        uint64_t base = hasher(input);
+        for (size_t bit = 0; bit < inputBits; ++bit) {
+            auto changed = input;
+            flipBit(changed, bit);
+            uint64_t diff = base ^ static_cast<uint64_t>(hasher(changed));
+            for (size_t out = 0; out < 64; ++out) flips[bit * 64 + out] += (diff >> out) & 1;
+        }
+    }
+    double worst = 0, sum = 0;
+    for (uint32_t f : flips) {
+        double bias = fabs(2.0 * f / trials - 1.0);
+        worst = max(worst, bias);
+        sum += bias;
+    }
+    cout << "  " << left << setw(38) << label << right << fixed << setprecision(3) << setw(8) << worst << "   "
+         << setw(8) << sum / flips.size() << defaultfloat << setprecision(6) << "\n";
+}
+
+void hashQualityReport() {
+    const size_t n = 1 << 16;
+    vector<uint64_t> sequential, strided, timestamps;
+    vector<string> names;
+    mt19937_64 rng(9);
+    for (size_t i = 0; i < n; ++i) {
+        sequential.push_back(i);
+        strided.push_back(i * 4096); // Page-aligned addresses, sharded IDs
+        timestamps.push_back(1700000000000ULL + i * 1000); // Millisecond timestamps, one per second
+        names.push_back("user-" + to_string(i));
+    }
+
+    cout << "\nBucket spread, " << n << " keys in " << n << " buckets (ideal: 36.8% empty, chi-squared ratio 1.00):\n";
+    cout << "  " << left << setw(38) << "keys / hash" << right << "  empty   chi2/bucket   longest\n";
+    hash<uint64_t> identity;
+    reportDistribution("sequential ints / std::hash", identity, sequential);
+    reportDistribution("sequential ints / IntegerHash", IntegerHash(), sequential);
+    reportDistribution("multiples of 4096 / std::hash", identity, strided);
+    reportDistribution("multiples of 4096 / IntegerHash", IntegerHash(), strided);
+    reportDistribution("ms timestamps / std::hash", identity, timestamps);
+    reportDistribution("ms timestamps / IntegerHash", IntegerHash(), timestamps);
+    reportDistribution("\"user-N\" names / std::hash", hash<string>(), names);
+    reportDistribution("\"user-N\" names / WyHash", WyHash(), names);
+    reportDistribution("\"user-N\" names / Xxh3Hash", Xxh3Hash(), names);
+
+    cout << "\nAvalanche bias (0 is ideal; sampling noise alone gives about 0.07 worst, 0.013 mean):\n";
+    cout << "  " << left << setw(38) << "input / hash" << right << "   worst      mean\n";
+    auto randomInt = [&]() { return rng(); };
+    auto flipInt = [](uint64_t& x, size_t bit) { x ^= uint64_t(1) << bit; };
+    reportAvalanche("uint64 / std::hash", identity, 64, randomInt, flipInt);
+    reportAvalanche("uint64 / IntegerHash", IntegerHash(), 64, randomInt, flipInt);
+    for (size_t len : {size_t(5), size_t(12), size_t(40), size_t(200), size_t(600)}) {
+        auto randomString = [&, len]() {
+            string s(len, '\0');
+            for (auto& c : s) c = static_cast<char>(rng());
+            return s;
+        };
+        auto flipString = [](string& s, size_t bit) { s[bit / 8] ^= static_cast<char>(1 << (bit % 8)); };
+        size_t bits = min<size_t>(len * 8, 256); // Long keys: the first 32 bytes
+        string suffix = " (" + to_string(len) + " bytes)";
+        reportAvalanche("string" + suffix + " / std::hash", hash<string>(), bits, randomString, flipString);
+        reportAvalanche("string" + suffix + " / WyHash", WyHash(), bits, randomString, flipString);
+        reportAvalanche("string" + suffix + " / Xxh3Hash", Xxh3Hash(), bits, randomString, flipString);
+    }
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void hashFunctionsBenchmark() {
+    mt19937_64 rng(3);
+    cout << "\nHash throughput, ns per key (key bytes in column 1):\n";
+    cout << "   bytes   std::hash     WyHash   Xxh3Hash\n";
+    for (size_t len : {3, 8, 16, 24, 48, 100, 200, 1000, 10000}) {
+        size_t count = max<size_t>(1000, 4000000 / (len + 16));
+        string storage(count * len, '\0');
+        for (auto& c : storage) c = static_cast<char>('a' + rng() % 26);
+        vector<string_view> keys;
+        for (size_t i = 0; i < count; ++i) keys.push_back(string_view(storage).substr(i * len, len));
+        size_t rounds = max<size_t>(1, 20000000 / (count * (len + 16)));
+        uint64_t sa = 0, sb = 0, sc = 0;
+        double a = timeMs([&]() { for (size_t r = 0; r < rounds; ++r) for (auto k : keys) sa += hash<string_view>()(k); });
+        double b = timeMs([&]() { for (size_t r = 0; r < rounds; ++r) for (auto k : keys) sb += WyHash()(k); });
+        double c = timeMs([&]() { for (size_t r = 0; r < rounds; ++r) for (auto k : keys) sc += Xxh3Hash()(k); });
+        double perKey = 1e6 / double(rounds * count);
+        cout << fixed << setprecision(2) << setw(8) << len << setw(12) << a * perKey << setw(11) << b * perKey
+             << setw(11) << c * perKey << defaultfloat << setprecision(6) << "\n";
+        if (sa + sb + sc == 42) cout << "";
+    }
+
+    // unordered_map lookups with the demo's key shape
+    const size_t n = 200000, lookups = 2000000;
+    vector<string> keys;
+    for (size_t i = 0; i < n; ++i) keys.push_back("user-" + to_string(rng() % 100000000));
+    vector<size_t> probes;
+    for (size_t i = 0; i < lookups; ++i) probes.push_back(rng() % n);
+    unordered_map<string, int> standard;
+    unordered_map<string, int, WyHash> wy;
+    unordered_map<string, int, Xxh3Hash> xx;
+    for (size_t i = 0; i < n; ++i) {
+        standard.emplace(keys[i], int(i));
+        wy.emplace(keys[i], int(i));
+        xx.emplace(keys[i], int(i));
+    }
+    long long sa = 0, sb = 0, sc = 0;
+    double a = timeMs([&]() { for (size_t p : probes) sa += standard.find(keys[p])->second; });
+    double b = timeMs([&]() { for (size_t p : probes) sb += wy.find(keys[p])->second; });
+    double c = timeMs([&]() { for (size_t p : probes) sc += xx.find(keys[p])->second; });
+    cout << "\n" << lookups << " unordered_map<string,int>::find on \"user-N\" keys:\n";
+    cout << "  std::hash: " << a << " ms, WyHash: " << b << " ms, Xxh3Hash: " << c << " ms\n";
+    cout << "  Results agree: " << (sa == sb && sb == sc ? "Yes" : "No") << endl;
+
+    // Integer hashing, one at a time and batched
+    vector<uint64_t> ids(1 << 12), out(ids.size());
+    for (auto& id : ids) id = rng();
+    const size_t rounds = 20000;
+    uint64_t checksum = 0;
+    double scalar = timeMs([&]() {
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < ids.size(); ++i) out[i] = IntegerHash()(ids[i]);
+            checksum += out[r % ids.size()];
+            ++ids[r % ids.size()];
+        }
+    });
+    double batched = timeMs([&]() {
+        for (size_t r = 0; r < rounds; ++r) {
+            hashBatch(IntegerHash(), ids.data(), ids.size(), out.data());
+            checksum += out[r % ids.size()];
+            ++ids[r % ids.size()];
+        }
+    });
+    double total = double(rounds * ids.size());
+#if defined(__AVX512DQ__)
+    const char* path = "AVX-512";
+#elif defined(__SSE2__)
+    const char* path = "SSE2";
+#else
+    const char* path = "scalar";
+#endif
+    cout << "\nIntegerHash over " << ids.size() << " keys x " << rounds << ": one at a time " << scalar * 1e6 / total
+         << " ns/key, hashBatch (" << path << ") " << batched * 1e6 / total << " ns/key\n";
+    if (checksum == 42) cout << "";
+}
+
+int main() {
+    hashFunctionsUsage();
+    cout << "Hash self-check: " << (hashFunctionsSelfCheck() ? "passed" : "FAILED") << endl;
+    hashQualityReport();
+    hashFunctionsBenchmark();
+    return 0;
+}
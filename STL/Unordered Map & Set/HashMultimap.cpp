@@ -0,0 +1,432 @@
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <new>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Hash Multimap With Contiguous Values Per Key:
+ *
+ * 1. **Problem**:
+ *    - multimapUsage() stores ("Alice", 25) and ("Alice", 35) as two tree nodes, each with its own
+ *      copy of the key, three pointers and a color. "All values for Alice" then walks a linked
+ *      path through the tree, and count("Alice") walks it too.
+ *
+ * 2. **HashMultimap<Key, Value, N>**:
+ *    - Each key is stored once, in a hash table, next to a SmallVector of its values. The first N
+ *      values live inside the table entry itself; more spill to one heap array that grows by
+ *      doubling. Values keep their insertion order, as in multimap.
+ *    - equal_range(key) returns a Span: a pointer and a length over the values, empty if the key
+ *      is absent. Iterating it is a plain array scan.
+ *    - count(key) is the vector's size: O(1) after the hash lookup. erase(key) drops the key and
+ *      all its values at once; erase_one(key, value) removes a single value.
+ *    - Also: insert({key, value}), emplace, size (values), key_count, empty, clear, reserve,
+ *      and begin/end over (key, values) pairs.
+ *    - A Span stays valid until that key is erased or gets another value (which may move its array).
+ *    - Allocator is used for the table and for spilled arrays, so memory can be measured.
+ */
+
+template <typename T, size_t N, typename Allocator = allocator<T>>
+class SmallVector {
+private:
+    using Traits = allocator_traits<Allocator>;
+
+    alignas(T) unsigned char inlineStorage[N * sizeof(T)];
+    T* data_;
+    size_t count;
+    size_t capacity;
+    Allocator alloc;
+
+    bool isInline() const { return data_ == reinterpret_cast<const T*>(inlineStorage); }
+    T* inlineData() { return reinterpret_cast<T*>(inlineStorage); }
+
+    // Builds the new element in the bigger buffer before moving the old ones, so arguments that
+    // refer into this vector (v.emplace_back(v[0])) are still alive when they are read
+    template <typename... Args>
+    T* growAndEmplace(Args&&... args) {
+        size_t newCapacity = capacity * 2;
+        T* bigger = Traits::allocate(alloc, newCapacity);
+        try {
+            new (bigger + count) T(forward<Args>(args)...);
+        } catch (...) {
+            Traits::deallocate(alloc, bigger, newCapacity);
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            new (bigger + i) T(move(data_[i]));
+            data_[i].~T();
+        }
+        release();
+        data_ = bigger;
+        capacity = newCapacity;
+        return data_ + count;
+    }
+
+    void release() {
+        if (!isInline()) Traits::deallocate(alloc, data_, capacity);
+    }
+
+public:
+    explicit SmallVector(const Allocator& alloc = Allocator())
+        : data_(inlineData()), count(0), capacity(N), alloc(alloc) {
+        static_assert(N > 0, "SmallVector needs at least one inline slot");
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector(other.alloc) {
+        for (const T& v : other) push_back(v);
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector(other.alloc) {
+        if (!other.isInline()) { // Take the heap array
+            data_ = other.data_;
+            count = other.count;
+            capacity = other.capacity;
+            other.data_ = other.inlineData();
+            other.count = 0;
+            other.capacity = N;
+        } else {
+            for (T& v : other) push_back(move(v));
+            other.clear();
+        }
+    }
+
+    SmallVector& operator=(SmallVector other) {
+        clear();
+        release();
+        data_ = inlineData();
+        capacity = N;
+        if (!other.isInline()) {
+            data_ = other.data_;
+            count = other.count;
+            capacity = other.capacity;
+            other.data_ = other.inlineData();
+            other.count = 0;
+            other.capacity = N;
+        } else {
+            for (T& v : other) push_back(move(v));
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        release();
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        T* slot = count == capacity ? growAndEmplace(forward<Args>(args)...) : new (data_ + count) T(forward<Args>(args)...);
+        ++count;
+        return *slot;
+    }
+
+    // Removes element i, keeping the order of the rest
+    void erase(size_t i) {
+        for (; i + 1 < count; ++i) data_[i] = move(data_[i + 1]);
+        data_[--count].~T();
+    }
+
+    void clear() {
+        while (count > 0) data_[--count].~T();
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + count; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + count; }
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool spilled() const { return !isInline(); }
+    size_t heapBytes() const { return isInline() ? 0 : capacity * sizeof(T); }
+};
+
+// A view of contiguous values: what equal_range returns (std::span arrives in C++20)
+template <typename T>
+class Span {
+public:
+    Span() : first(nullptr), length(0) {}
+    Span(T* first, size_t length) : first(first), length(length) {}
+
+    T* begin() const { return first; }
+    T* end() const { return first + length; }
+    T& operator[](size_t i) const { return first[i]; }
+    T& front() const { return first[0]; }
+    T& back() const { return first[length - 1]; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+private:
+    T* first;
+    size_t length;
+};
+
+template <typename Key, typename Value, size_t N = 2, typename Hash = hash<Key>, typename Equal = equal_to<Key>,
+          typename Allocator = allocator<pair<const Key, Value>>>
+class HashMultimap {
+public:
+    using ValueAllocator = typename allocator_traits<Allocator>::template rebind_alloc<Value>;
+    using Values = SmallVector<Value, N, ValueAllocator>;
+    using EntryAllocator = typename allocator_traits<Allocator>::template rebind_alloc<pair<const Key, Values>>;
+    using Table = unordered_map<Key, Values, Hash, Equal, EntryAllocator>;
+    using const_iterator = typename Table::const_iterator;
+
+    HashMultimap() : elements(0) {}
+
+    Value& insert(const pair<Key, Value>& kv) { return emplace(kv.first, kv.second); }
+
+    template <typename... Args>
+    Value& emplace(const Key& key, Args&&... args) {
+        auto it = table.find(key);
+        if (it == table.end()) it = table.emplace(key, Values(ValueAllocator(table.get_allocator()))).first;
+        ++elements;
+        return it->second.emplace_back(forward<Args>(args)...);
+    }
+
+    Span<const Value> equal_range(const Key& key) const {
+        auto it = table.find(key);
+        return it == table.end() ? Span<const Value>() : Span<const Value>(it->second.data(), it->second.size());
+    }
+
+    Span<Value> equal_range(const Key& key) {
+        auto it = table.find(key);
+        return it == table.end() ? Span<Value>() : Span<Value>(it->second.data(), it->second.size());
+    }
+
+    size_t count(const Key& key) const {
+        auto it = table.find(key);
+        return it == table.end() ? 0 : it->second.size();
+    }
+
+    bool contains(const Key& key) const { return table.find(key) != table.end(); }
+
+    // Removes the key and all its values; returns how many values were removed
+    size_t erase(const Key& key) {
+        auto it = table.find(key);
+        if (it == table.end()) return 0;
+        size_t removed = it->second.size();
+        table.erase(it);
+        elements -= removed;
+        return removed;
+    }
+
+    // Removes the first value equal to value under key
+    bool erase_one(const Key& key, const Value& value) {
+        auto it = table.find(key);
+        if (it == table.end()) return false;
+        Values& values = it->second;
+        auto found = find(values.begin(), values.end(), value);
+        if (found == values.end()) return false;
+        values.erase(found - values.begin());
+        if (values.empty()) table.erase(it);
+        --elements;
+        return true;
+    }
+
+    size_t size() const { return elements; }
+    size_t key_count() const { return table.size(); }
+    bool empty() const { return elements == 0; }
+    void reserve(size_t keys) { table.reserve(keys); }
+
+    void clear() {
+        table.clear();
+        elements = 0;
+    }
+
+    // Iterates (key, values) pairs; values is a SmallVector, so `for (auto& v : it->second)` works
+    const_iterator begin() const { return table.begin(); }
+    const_iterator end() const { return table.end(); }
+
+private:
+    Table table;
+    size_t elements;
+};
+
+// Same steps as multimapUsage()
+void hashMultimapUsage() {
+    HashMultimap<string, int> mm;
+    mm.insert({"Alice", 25});
+    mm.insert({"Bob", 30});
+    mm.insert({"Alice", 35}); // Duplicate key: appended to Alice's values
+    mm.insert({"Charlie", 40});
+
+    cout << "Hash multimap after insertions:\n";
+    for (const auto& [name, ages] : mm) {
+        cout << name << ":";
+        for (int age : ages) cout << " " << age;
+        cout << endl; // Output: Alice: 25 35, Bob: 30, Charlie: 40 (keys in any order)
+    }
+
+    cout << "Count of Alice: " << mm.count("Alice") << endl; // Output: 2
+    cout << "Alice's values: ";
+    for (int age : mm.equal_range("Alice")) cout << age << " "; // Output: 25 35
+    cout << endl;
+
+    mm.erase("Alice");
+    cout << "Size after removing all entries for Alice: " << mm.size() << endl; // Output: 2
+    mm.erase_one("Bob", 30);
+    cout << "Keys after removing Bob's only value: " << mm.key_count() << endl; // Output: 1
+    mm.clear();
+    cout << "Hash multimap size after clear: " << mm.size() << endl; // Output: 0
+}
+
+// Random inserts and erases compared with multimap, including keys that spill past N values
+bool hashMultimapSelfCheck() {
+    mt19937 rng(49);
+    HashMultimap<int, string, 2> hm;
+    multimap<int, string> mm;
+    for (int i = 0; i < 100000; ++i) {
+        int key = rng() % 500;
+        uint32_t op = rng() % 10;
+        if (op == 5 && hm.count(key)) { // The new value aliases an existing one, also when that forces a spill
+            hm.emplace(key, hm.equal_range(key)[0]);
+            mm.insert({key, mm.lower_bound(key)->second});
+        } else if (op < 6) {
+            string v = to_string(rng() % 50);
+            hm.insert({key, v});
+            mm.insert({key, v});
+        } else if (op == 6) {
+            if (hm.erase(key) != mm.erase(key)) return false;
+        } else if (op == 7) {
+            string v = to_string(rng() % 50);
+            auto range = mm.equal_range(key);
+            auto it = find_if(range.first, range.second, [&](const pair<const int, string>& p) { return p.second == v; });
+            bool expected = it != range.second;
+            if (expected) mm.erase(it);
+            if (hm.erase_one(key, v) != expected) return false;
+        } else {
+            auto range = mm.equal_range(key);
+            Span<const string> values = static_cast<const HashMultimap<int, string, 2>&>(hm).equal_range(key);
+            if (hm.count(key) != mm.count(key) || values.size() != mm.count(key)) return false;
+            size_t k = 0;
+            for (auto it = range.first; it != range.second; ++it, ++k) // Same values, same order
+                if (values[k] != it->second) return false;
+        }
+    }
+    if (hm.size() != mm.size()) return false;
+    HashMultimap<int, string, 2> copy = hm; // Copies keep inline and spilled values alike
+    for (auto& [key, values] : copy)
+        if (values.size() != mm.count(key)) return false;
+    return true;
+}
+
+struct AllocationCounter {
+    static size_t bytes;
+};
+size_t AllocationCounter::bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        AllocationCounter::bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        AllocationCounter::bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void hashMultimapBenchmark() {
+    const size_t keys = 200000;
+    mt19937 rng(11);
+    vector<string> names;
+    for (size_t i = 0; i < keys; ++i) names.push_back("user" + to_string(1000000 + i)); // Short: no string allocation
+    // Values per key: mostly a few, some many (geometric-ish, mean about 10), inserted interleaved
+    vector<pair<size_t, int>> inserts;
+    for (size_t k = 0; k < keys; ++k) {
+        size_t values = 1 + rng() % 4 + (rng() % 4 == 0 ? rng() % 30 : 0);
+        for (size_t v = 0; v < values; ++v) inserts.push_back({k, static_cast<int>(rng() % 100)});
+    }
+    shuffle(inserts.begin(), inserts.end(), rng);
+
+    using CountedMultimap = multimap<string, int, less<string>, CountingAllocator<pair<const string, int>>>;
+    using CountedHashMultimap = HashMultimap<string, int, 4, hash<string>, equal_to<string>, CountingAllocator<pair<const string, int>>>;
+    size_t before = AllocationCounter::bytes;
+    CountedMultimap mm;
+    double ta = timeMs([&]() { for (auto& [k, v] : inserts) mm.insert({names[k], v}); });
+    size_t treeBytes = AllocationCounter::bytes - before;
+    before = AllocationCounter::bytes;
+    CountedHashMultimap hm;
+    double tb = timeMs([&]() { for (auto& [k, v] : inserts) hm.insert({names[k], v}); });
+    size_t hashBytes = AllocationCounter::bytes - before;
+
+    cout << "\n" << inserts.size() << " values under " << keys << " keys (multimap / HashMultimap<string, int, 4>):\n";
+    cout << "  build:                     " << ta << " / " << tb << " ms\n";
+    cout << "  bytes per value:           " << double(treeBytes) / mm.size() << " / " << double(hashBytes) / hm.size() << " ("
+         << double(treeBytes) / hashBytes << "x smaller, excluding malloc headers)\n";
+
+    vector<size_t> probes(1000000);
+    for (auto& p : probes) p = rng() % keys;
+    long long sa = 0, sb = 0;
+    ta = timeMs([&]() {
+        for (size_t p : probes) {
+            auto range = mm.equal_range(names[p]);
+            for (auto it = range.first; it != range.second; ++it) sa += it->second;
+        }
+    });
+    tb = timeMs([&]() {
+        for (size_t p : probes)
+            for (int v : hm.equal_range(names[p])) sb += v;
+    });
+    cout << "  " << probes.size() << " equal_range scans: " << ta << " / " << tb << " ms\n";
+
+    ta = timeMs([&]() { for (size_t p : probes) sa += mm.count(names[p]); });
+    tb = timeMs([&]() { for (size_t p : probes) sb += hm.count(names[p]); });
+    cout << "  " << probes.size() << " count():           " << ta << " / " << tb << " ms\n";
+
+    ta = timeMs([&]() { for (auto& kv : mm) sa += kv.second; });
+    tb = timeMs([&]() {
+        for (auto& entry : hm)
+            for (int v : entry.second) sb += v;
+    });
+    cout << "  full scan:                 " << ta << " / " << tb << " ms\n";
+
+    ta = timeMs([&]() { for (size_t k = 0; k < keys; k += 2) sa += mm.erase(names[k]); });
+    tb = timeMs([&]() { for (size_t k = 0; k < keys; k += 2) sb += hm.erase(names[k]); });
+    cout << "  erase(key), half the keys: " << ta << " / " << tb << " ms\n";
+    cout << "  Results agree: " << (sa == sb && mm.size() == hm.size() ? "Yes" : "No") << endl;
+}
+
+int main() {
+    hashMultimapUsage();
+    cout << "Self-check against multimap: " << (hashMultimapSelfCheck() ? "passed" : "FAILED") << endl;
+    hashMultimapBenchmark();
+    return 0;
+}
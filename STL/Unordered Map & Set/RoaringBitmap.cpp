@@ -0,0 +1,910 @@
+#include <iostream>
+#include <unordered_set>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Roaring Bitmap Integer Set:
+ *
+ * 1. **Problem**:
+ *    - unordered_set<int> spends about 40 bytes per 4-byte ID (a malloc'd node plus a bucket
+ *      pointer), and intersecting two sets means one hash lookup per element.
+ *
+ * 2. **RoaringBitmap** (a set of uint32_t):
+ *    - Values are grouped by their high 16 bits into chunks of 65536. Each non-empty chunk is
+ *      stored in whichever of three containers suits it:
+ *      - array: sorted uint16_t low halves, for chunks with at most 4096 values (2 bytes each).
+ *      - bitmap: 65536 bits (8 KB), for denser chunks (1 bit per possible value).
+ *      - run: (start, length) pairs, for chunks made of long consecutive stretches.
+ *    - insert and erase switch between array and bitmap as the chunk crosses 4096 values;
+ *      runOptimize() converts every chunk to its smallest form (typically after bulk loading).
+ *    - Set algebra (&, |, -, and their assigning forms) works chunk by chunk. Bitmap-with-bitmap
+ *      chunks are combined 128 bits per SSE2 instruction, with the result's cardinality counted
+ *      in the same pass by a vector popcount (x86-64 without -mpopcnt has no popcount
+ *      instruction). andCardinality() counts an intersection without building it.
+ *    - Operations (same as the demo): insert, erase, count, contains, size, empty, clear,
+ *      begin/end (ascending order), plus for_each, memoryBytes, runOptimize.
+ *    - serialize()/deserialize() use a fixed little-endian byte layout, so a bitmap written on
+ *      one machine reads back on any other. deserialize() validates its input and throws
+ *      runtime_error on malformed data. (It is this file's own format, not the Roaring spec's.)
+ */
+
+class RoaringBitmap {
+public:
+    static constexpr size_t ArrayMax = 4096;
+    static constexpr size_t BitmapWords = 1024;
+
+private:
+    enum class Kind : uint8_t { Array, Bitmap, Run };
+    enum class Op { And, Or, AndNot };
+
+    struct Container {
+        Kind kind = Kind::Array;
+        uint32_t cardinality = 0;
+        vector<uint16_t> values; // Array: sorted values. Run: (start, length - 1) pairs
+        vector<uint64_t> words;  // Bitmap: BitmapWords words
+    };
+
+    vector<uint16_t> keys; // High halves, ascending; keys[i] owns containers[i]
+    vector<Container> containers;
+
+    static uint32_t popcount(uint64_t x) { return static_cast<uint32_t>(__builtin_popcountll(x)); }
+
+    // out = a op b over a whole bitmap; returns the popcount of out. out may be null (count only)
+    static uint32_t combineWords(const uint64_t* a, const uint64_t* b, uint64_t* out, Op op) {
+#ifdef __SSE2__
+        const __m128i m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0f);
+        __m128i total = _mm_setzero_si128();
+        for (size_t i = 0; i < BitmapWords; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i r = op == Op::And ? _mm_and_si128(x, y) : op == Op::Or ? _mm_or_si128(x, y) : _mm_andnot_si128(y, x);
+            if (out) _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+            // Bit counts per 2, 4, then 8 bits; sad sums the 8 byte counts of each half
+            r = _mm_sub_epi8(r, _mm_and_si128(_mm_srli_epi64(r, 1), m1));
+            r = _mm_add_epi8(_mm_and_si128(r, m2), _mm_and_si128(_mm_srli_epi64(r, 2), m2));
+            r = _mm_and_si128(_mm_add_epi8(r, _mm_srli_epi64(r, 4)), m4);
+            total = _mm_add_epi64(total, _mm_sad_epu8(r, _mm_setzero_si128()));
+        }
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8)));
+#else
+        uint32_t count = 0;
+        for (size_t i = 0; i < BitmapWords; ++i) {
+            uint64_t r = op == Op::And ? a[i] & b[i] : op == Op::Or ? a[i] | b[i] : a[i] & ~b[i];
+            if (out) out[i] = r;
+            count += popcount(r);
+        }
+        return count;
+#endif
+    }
+
+    // Calls f(low) for every value of c in ascending order
+    template <typename F>
+    static void forEachValue(const Container& c, F&& f) {
+        if (c.kind == Kind::Array) {
+            for (uint16_t v : c.values) f(v);
+        } else if (c.kind == Kind::Bitmap) {
+            for (size_t w = 0; w < BitmapWords; ++w)
+                for (uint64_t bits = c.words[w]; bits; bits &= bits - 1)
+                    f(static_cast<uint16_t>(w * 64 + __builtin_ctzll(bits)));
+        } else {
+            for (size_t r = 0; r < c.values.size(); r += 2)
+                for (uint32_t v = c.values[r]; v <= uint32_t(c.values[r]) + c.values[r + 1]; ++v) f(static_cast<uint16_t>(v));
+        }
+    }
+
+    static bool contains(const Container& c, uint16_t low) {
+        if (c.kind == Kind::Array) return binary_search(c.values.begin(), c.values.end(), low);
+        if (c.kind == Kind::Bitmap) return (c.words[low >> 6] >> (low & 63)) & 1;
+        size_t r = runBefore(c, low);
+        return r != SIZE_MAX && low <= uint32_t(c.values[r]) + c.values[r + 1];
+    }
+
+    // Index (into values) of the last run starting at or before low, or SIZE_MAX
+    static size_t runBefore(const Container& c, uint16_t low) {
+        size_t lo = 0, hi = c.values.size() / 2; // Runs [0, hi)
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (c.values[2 * mid] <= low) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo == 0 ? SIZE_MAX : 2 * (lo - 1);
+    }
+
+    // Sets bits [first, last] a word at a time
+    static void setRange(uint64_t* words, uint32_t first, uint32_t last) {
+        uint32_t fw = first >> 6, lw = last >> 6;
+        uint64_t headMask = ~uint64_t(0) << (first & 63), tailMask = ~uint64_t(0) >> (63 - (last & 63));
+        if (fw == lw) {
+            words[fw] |= headMask & tailMask;
+            return;
+        }
+        words[fw] |= headMask;
+        for (uint32_t w = fw + 1; w < lw; ++w) words[w] = ~uint64_t(0);
+        words[lw] |= tailMask;
+    }
+
+    static Container makeBitmap(const Container& c) {
+        Container b;
+        b.kind = Kind::Bitmap;
+        b.words.assign(BitmapWords, 0);
+        if (c.kind == Kind::Run) {
+            for (size_t r = 0; r < c.values.size(); r += 2) setRange(b.words.data(), c.values[r], uint32_t(c.values[r]) + c.values[r + 1]);
+        } else {
+            forEachValue(c, [&](uint16_t v) { b.words[v >> 6] |= uint64_t(1) << (v & 63); });
+        }
+        b.cardinality = c.cardinality;
+        return b;
+    }
+
+    static Container makeArray(const Container& c) {
+        Container a;
+        a.values.reserve(c.cardinality);
+        forEachValue(c, [&](uint16_t v) { a.values.push_back(v); });
+        a.cardinality = c.cardinality;
+        return a;
+    }
+
+    static Container makeRuns(const Container& c) {
+        Container r;
+        r.kind = Kind::Run;
+        uint32_t next = UINT32_MAX; // One past the end of the run being built
+        forEachValue(c, [&](uint16_t v) {
+            if (v == next) ++r.values.back();
+            else {
+                r.values.push_back(v);
+                r.values.push_back(0);
+            }
+            next = uint32_t(v) + 1;
+        });
+        r.cardinality = c.cardinality;
+        return r;
+    }
+
+    static size_t runCount(const Container& c) {
+        if (c.kind == Kind::Run) return c.values.size() / 2;
+        size_t runs = 0;
+        if (c.kind == Kind::Array) {
+            for (size_t i = 0; i < c.values.size(); ++i) runs += i == 0 || c.values[i] != c.values[i - 1] + 1;
+        } else {
+            uint64_t carry = 0; // Top bit of the previous word
+            for (uint64_t w : c.words) {
+                runs += popcount(w & ~((w << 1) | carry)); // Set bits whose lower neighbour is clear
+                carry = w >> 63;
+            }
+        }
+        return runs;
+    }
+
+    // Array or bitmap, whichever the cardinality calls for
+    static void normalize(Container& c) {
+        if (c.kind == Kind::Bitmap && c.cardinality <= ArrayMax) c = makeArray(c);
+        else if (c.kind == Kind::Array && c.cardinality > ArrayMax) c = makeBitmap(c);
+        else if (c.kind == Kind::Run && c.values.size() / 2 * 4 > min<size_t>(2 * c.cardinality, 8192))
+            c = c.cardinality <= ArrayMax ? makeArray(c) : makeBitmap(c); // Too fragmented to stay runs
+    }
+
+    static bool insertLow(Container& c, uint16_t low) {
+        if (c.kind == Kind::Array) {
+            auto it = lower_bound(c.values.begin(), c.values.end(), low);
+            if (it != c.values.end() && *it == low) return false;
+            c.values.insert(it, low);
+        } else if (c.kind == Kind::Bitmap) {
+            uint64_t& w = c.words[low >> 6];
+            uint64_t bit = uint64_t(1) << (low & 63);
+            if (w & bit) return false;
+            w |= bit;
+        } else {
+            size_t r = runBefore(c, low);
+            uint32_t end = r == SIZE_MAX ? 0 : uint32_t(c.values[r]) + c.values[r + 1];
+            if (r != SIZE_MAX && low <= end) return false;
+            size_t next = r == SIZE_MAX ? 0 : r + 2;
+            bool joinsPrevious = r != SIZE_MAX && low == end + 1;
+            bool joinsNext = next < c.values.size() && uint32_t(low) + 1 == c.values[next];
+            if (joinsPrevious && joinsNext) {
+                c.values[r + 1] = static_cast<uint16_t>(uint32_t(c.values[next]) + c.values[next + 1] - c.values[r]);
+                c.values.erase(c.values.begin() + next, c.values.begin() + next + 2);
+            } else if (joinsPrevious) {
+                ++c.values[r + 1];
+            } else if (joinsNext) {
+                c.values[next] = low;
+                ++c.values[next + 1];
+            } else {
+                uint16_t run[2] = {low, 0};
+                c.values.insert(c.values.begin() + next, run, run + 2);
+            }
+        }
+        ++c.cardinality;
+        normalize(c);
+        return true;
+    }
+
+    static bool eraseLow(Container& c, uint16_t low) {
+        if (c.kind == Kind::Array) {
+            auto it = lower_bound(c.values.begin(), c.values.end(), low);
+            if (it == c.values.end() || *it != low) return false;
+            c.values.erase(it);
+        } else if (c.kind == Kind::Bitmap) {
+            uint64_t& w = c.words[low >> 6];
+            uint64_t bit = uint64_t(1) << (low & 63);
+            if (!(w & bit)) return false;
+            w &= ~bit;
+        } else {
+            size_t r = runBefore(c, low);
+            if (r == SIZE_MAX) return false;
+            uint16_t start = c.values[r];
+            uint32_t end = uint32_t(start) + c.values[r + 1];
+            if (low > end) return false;
+            if (start == end) {
+                c.values.erase(c.values.begin() + r, c.values.begin() + r + 2);
+            } else if (low == start) {
+                ++c.values[r];
+                --c.values[r + 1];
+            } else if (low == end) {
+                --c.values[r + 1];
+            } else { // Split in two around low
+                c.values[r + 1] = static_cast<uint16_t>(low - 1 - start);
+                uint16_t run[2] = {static_cast<uint16_t>(low + 1), static_cast<uint16_t>(end - low - 1)};
+                c.values.insert(c.values.begin() + r + 2, run, run + 2);
+            }
+        }
+        --c.cardinality;
+        normalize(c);
+        return true;
+    }
+
+    // Run with run: sweep the two interval lists, producing runs directly
+    static Container combineRuns(const Container& a, const Container& b, Op op) {
+        Container out;
+        out.kind = Kind::Run;
+        auto emit = [&](uint32_t first, uint32_t last) { // Inclusive; coalesces with the previous run
+            if (!out.values.empty() && first <= uint32_t(out.values[out.values.size() - 2]) + out.values.back() + 1) {
+                uint32_t start = out.values[out.values.size() - 2];
+                last = max(last, start + out.values.back());
+                out.cardinality -= out.values.back() + 1;
+                out.values.back() = static_cast<uint16_t>(last - start);
+                out.cardinality += last - start + 1;
+                return;
+            }
+            out.values.push_back(static_cast<uint16_t>(first));
+            out.values.push_back(static_cast<uint16_t>(last - first));
+            out.cardinality += last - first + 1;
+        };
+        auto first = [](const Container& c, size_t r) { return uint32_t(c.values[r]); };
+        auto last = [](const Container& c, size_t r) { return uint32_t(c.values[r]) + c.values[r + 1]; };
+        size_t i = 0, j = 0, n = a.values.size(), m = b.values.size();
+        if (op == Op::Or) {
+            while (i < n || j < m) {
+                if (j == m || (i < n && first(a, i) <= first(b, j))) {
+                    emit(first(a, i), last(a, i));
+                    i += 2;
+                } else {
+                    emit(first(b, j), last(b, j));
+                    j += 2;
+                }
+            }
+        } else if (op == Op::And) {
+            while (i < n && j < m) {
+                uint32_t lo = max(first(a, i), first(b, j)), hi = min(last(a, i), last(b, j));
+                if (lo <= hi) emit(lo, hi);
+                if (last(a, i) < last(b, j)) i += 2;
+                else j += 2;
+            }
+        } else {
+            for (; i < n; i += 2) { // Cut every run of b out of the current run of a
+                uint32_t lo = first(a, i), hi = last(a, i);
+                while (j < m && last(b, j) < lo) j += 2;
+                for (size_t k = j; k < m && first(b, k) <= hi; k += 2) {
+                    if (first(b, k) > lo) emit(lo, first(b, k) - 1);
+                    lo = max(lo, last(b, k) + 1);
+                }
+                if (lo <= hi) emit(lo, hi);
+            }
+        }
+        normalize(out);
+        return out;
+    }
+
+    // Combines two containers of the same chunk; the result may be empty
+    static Container combine(const Container& a, const Container& b, Op op) {
+        if (a.kind == Kind::Run && b.kind == Kind::Run) return combineRuns(a, b, op);
+        if (a.kind == Kind::Run || b.kind == Kind::Run) {
+            auto plain = [](const Container& c) { return c.kind != Kind::Run ? c : c.cardinality <= ArrayMax ? makeArray(c) : makeBitmap(c); };
+            return combine(a.kind == Kind::Run ? plain(a) : a, b.kind == Kind::Run ? plain(b) : b, op);
+        }
+        Container out;
+        if (a.kind == Kind::Bitmap && b.kind == Kind::Bitmap) {
+            out.kind = Kind::Bitmap;
+            out.words.resize(BitmapWords);
+            out.cardinality = combineWords(a.words.data(), b.words.data(), out.words.data(), op);
+        } else if (a.kind == Kind::Array && b.kind == Kind::Array) {
+            auto& av = a.values;
+            auto& bv = b.values;
+            if (op == Op::And) set_intersection(av.begin(), av.end(), bv.begin(), bv.end(), back_inserter(out.values));
+            else if (op == Op::Or) set_union(av.begin(), av.end(), bv.begin(), bv.end(), back_inserter(out.values));
+            else set_difference(av.begin(), av.end(), bv.begin(), bv.end(), back_inserter(out.values));
+            out.cardinality = static_cast<uint32_t>(out.values.size());
+        } else if (op == Op::Or) { // One array, one bitmap: set the array's bits in a copy of the bitmap
+            const Container& bitmap = a.kind == Kind::Bitmap ? a : b;
+            const Container& array = a.kind == Kind::Bitmap ? b : a;
+            out = bitmap;
+            for (uint16_t v : array.values) {
+                uint64_t& w = out.words[v >> 6];
+                out.cardinality += !((w >> (v & 63)) & 1);
+                w |= uint64_t(1) << (v & 63);
+            }
+        } else if (a.kind == Kind::Array) { // Array & bitmap, array - bitmap: filter the array
+            bool keepIfPresent = op == Op::And;
+            for (uint16_t v : a.values)
+                if (contains(b, v) == keepIfPresent) out.values.push_back(v);
+            out.cardinality = static_cast<uint32_t>(out.values.size());
+        } else if (op == Op::And) { // Bitmap & array
+            for (uint16_t v : b.values)
+                if (contains(a, v)) out.values.push_back(v);
+            out.cardinality = static_cast<uint32_t>(out.values.size());
+        } else { // Bitmap - array: clear the array's bits
+            out = a;
+            for (uint16_t v : b.values) {
+                uint64_t& w = out.words[v >> 6];
+                out.cardinality -= (w >> (v & 63)) & 1;
+                w &= ~(uint64_t(1) << (v & 63));
+            }
+        }
+        normalize(out);
+        return out;
+    }
+
+    static uint32_t intersectionSize(const Container& a, const Container& b) {
+        if (a.kind == Kind::Bitmap && b.kind == Kind::Bitmap) return combineWords(a.words.data(), b.words.data(), nullptr, Op::And);
+        if (a.kind == Kind::Array || b.kind == Kind::Array) { // Probe the array's values in the other
+            const Container& array = a.kind == Kind::Array ? a : b;
+            const Container& other = a.kind == Kind::Array ? b : a;
+            uint32_t count = 0;
+            for (uint16_t v : array.values) count += contains(other, v);
+            return count;
+        }
+        return combine(a, b, Op::And).cardinality;
+    }
+
+    // Chunk-by-chunk merge of two bitmaps' key lists
+    static RoaringBitmap combine(const RoaringBitmap& x, const RoaringBitmap& y, Op op) {
+        RoaringBitmap out;
+        size_t i = 0, j = 0;
+        while (i < x.keys.size() || j < y.keys.size()) {
+            bool fromX = j == y.keys.size() || (i < x.keys.size() && x.keys[i] < y.keys[j]);
+            bool fromY = i == x.keys.size() || (j < y.keys.size() && y.keys[j] < x.keys[i]);
+            if (fromX) { // Chunk only in x
+                if (op != Op::And) out.append(x.keys[i], x.containers[i]);
+                ++i;
+            } else if (fromY) { // Chunk only in y
+                if (op == Op::Or) out.append(y.keys[j], y.containers[j]);
+                ++j;
+            } else {
+                Container c = combine(x.containers[i], y.containers[j], op);
+                if (c.cardinality) out.append(x.keys[i], move(c));
+                ++i;
+                ++j;
+            }
+        }
+        return out;
+    }
+
+    void append(uint16_t key, Container c) {
+        keys.push_back(key);
+        containers.push_back(move(c));
+    }
+
+    size_t findChunk(uint16_t key) const {
+        auto it = lower_bound(keys.begin(), keys.end(), key);
+        return it != keys.end() && *it == key ? size_t(it - keys.begin()) : SIZE_MAX;
+    }
+
+    static void put16(vector<uint8_t>& out, uint16_t v) {
+        out.push_back(static_cast<uint8_t>(v));
+        out.push_back(static_cast<uint8_t>(v >> 8));
+    }
+
+    static void put32(vector<uint8_t>& out, uint32_t v) {
+        for (int s = 0; s < 32; s += 8) out.push_back(static_cast<uint8_t>(v >> s));
+    }
+
+    static void put64(vector<uint8_t>& out, uint64_t v) {
+        for (int s = 0; s < 64; s += 8) out.push_back(static_cast<uint8_t>(v >> s));
+    }
+
+    // Bounds-checked little-endian reader
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+
+        uint64_t get(size_t bytes) {
+            if (size - pos < bytes) throw runtime_error("RoaringBitmap: truncated input");
+            uint64_t v = 0;
+            for (size_t b = 0; b < bytes; ++b) v |= uint64_t(data[pos + b]) << (8 * b);
+            pos += bytes;
+            return v;
+        }
+    };
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = uint32_t;
+
+        const_iterator() : owner(nullptr), chunk(0), pos(0), offset(0), bits(0), current(0) {}
+
+        uint32_t operator*() const { return current; }
+
+        const_iterator& operator++() {
+            const Container& c = owner->containers[chunk];
+            if (c.kind == Kind::Array) {
+                ++pos;
+            } else if (c.kind == Kind::Bitmap) {
+                bits &= bits - 1;
+            } else if (offset < c.values[pos + 1]) {
+                ++offset;
+            } else {
+                pos += 2;
+                offset = 0;
+            }
+            settle();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return chunk == other.chunk && current == other.current; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class RoaringBitmap;
+        const RoaringBitmap* owner;
+        size_t chunk;
+        size_t pos;      // Array: index. Bitmap: word. Run: index of the run's start in values
+        uint32_t offset; // Run: position within the run
+        uint64_t bits;   // Bitmap: bits of word pos not visited yet
+        uint32_t current;
+
+        const_iterator(const RoaringBitmap* owner, size_t chunk) : owner(owner), chunk(chunk), pos(0), offset(0), bits(0), current(0) {
+            if (chunk < owner->containers.size() && owner->containers[chunk].kind == Kind::Bitmap) bits = owner->containers[chunk].words[0];
+            settle();
+        }
+
+        // Moves to the next valid value at or after the current state, crossing chunks as needed
+        void settle() {
+            while (chunk < owner->containers.size()) {
+                const Container& c = owner->containers[chunk];
+                uint32_t high = uint32_t(owner->keys[chunk]) << 16;
+                if (c.kind == Kind::Array) {
+                    if (pos < c.values.size()) {
+                        current = high | c.values[pos];
+                        return;
+                    }
+                } else if (c.kind == Kind::Bitmap) {
+                    while (!bits && ++pos < BitmapWords) bits = c.words[pos];
+                    if (bits) {
+                        current = high | uint32_t(pos * 64 + __builtin_ctzll(bits));
+                        return;
+                    }
+                } else if (pos < c.values.size()) {
+                    current = high | (c.values[pos] + offset);
+                    return;
+                }
+                ++chunk;
+                pos = 0;
+                offset = 0;
+                bits = chunk < owner->containers.size() && owner->containers[chunk].kind == Kind::Bitmap
+                           ? owner->containers[chunk].words[0] : 0;
+            }
+            current = 0; // end()
+        }
+    };
+
+    using iterator = const_iterator;
+
+    RoaringBitmap() {}
+
+    template <typename It>
+    RoaringBitmap(It first, It last) {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    RoaringBitmap(initializer_list<uint32_t> values) : RoaringBitmap(values.begin(), values.end()) {}
+
+    bool insert(uint32_t x) {
+        uint16_t key = x >> 16;
+        auto it = lower_bound(keys.begin(), keys.end(), key);
+        size_t i = it - keys.begin();
+        if (it == keys.end() || *it != key) {
+            keys.insert(it, key);
+            containers.insert(containers.begin() + i, Container());
+        }
+        return insertLow(containers[i], static_cast<uint16_t>(x));
+    }
+
+    size_t erase(uint32_t x) {
+        size_t i = findChunk(x >> 16);
+        if (i == SIZE_MAX || !eraseLow(containers[i], static_cast<uint16_t>(x))) return 0;
+        if (containers[i].cardinality == 0) {
+            keys.erase(keys.begin() + i);
+            containers.erase(containers.begin() + i);
+        }
+        return 1;
+    }
+
+    size_t count(uint32_t x) const {
+        size_t i = findChunk(x >> 16);
+        return i != SIZE_MAX && contains(containers[i], static_cast<uint16_t>(x));
+    }
+
+    bool contains(uint32_t x) const { return count(x) != 0; }
+
+    size_t size() const {
+        size_t total = 0;
+        for (auto& c : containers) total += c.cardinality;
+        return total;
+    }
+
+    bool empty() const { return keys.empty(); }
+
+    void clear() {
+        keys.clear();
+        containers.clear();
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, containers.size()); }
+
+    template <typename F>
+    void for_each(F f) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            uint32_t high = uint32_t(keys[i]) << 16;
+            forEachValue(containers[i], [&](uint16_t low) { f(high | low); });
+        }
+    }
+
+    // Converts every chunk to its smallest representation
+    void runOptimize() {
+        for (auto& c : containers) {
+            size_t runBytes = 4 * runCount(c), arrayBytes = 2 * size_t(c.cardinality), bitmapBytes = 8 * BitmapWords;
+            if (runBytes < min(arrayBytes, bitmapBytes)) {
+                if (c.kind != Kind::Run) c = makeRuns(c);
+            } else if (c.kind == Kind::Run) {
+                c = c.cardinality <= ArrayMax ? makeArray(c) : makeBitmap(c);
+            }
+            c.values.shrink_to_fit();
+        }
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = sizeof(*this) + keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+        for (auto& c : containers) bytes += c.values.capacity() * sizeof(uint16_t) + c.words.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+
+    friend RoaringBitmap operator&(const RoaringBitmap& a, const RoaringBitmap& b) { return combine(a, b, Op::And); }
+    friend RoaringBitmap operator|(const RoaringBitmap& a, const RoaringBitmap& b) { return combine(a, b, Op::Or); }
+    friend RoaringBitmap operator-(const RoaringBitmap& a, const RoaringBitmap& b) { return combine(a, b, Op::AndNot); }
+    RoaringBitmap& operator&=(const RoaringBitmap& other) { return *this = *this & other; }
+    RoaringBitmap& operator|=(const RoaringBitmap& other) { return *this = *this | other; }
+    RoaringBitmap& operator-=(const RoaringBitmap& other) { return *this = *this - other; }
+
+    // |a & b| without building the intersection
+    static size_t andCardinality(const RoaringBitmap& a, const RoaringBitmap& b) {
+        size_t total = 0;
+        for (size_t i = 0, j = 0; i < a.keys.size() && j < b.keys.size();) {
+            if (a.keys[i] < b.keys[j]) ++i;
+            else if (b.keys[j] < a.keys[i]) ++j;
+            else total += intersectionSize(a.containers[i++], b.containers[j++]);
+        }
+        return total;
+    }
+
+    bool operator==(const RoaringBitmap& other) const {
+        return size() == other.size() && equal(begin(), end(), other.begin(), other.end());
+    }
+    bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+    // Layout: "RBM1", u32 chunk count, then per chunk: u16 key, u8 kind, u32 cardinality and
+    // the payload (array: u16 values; bitmap: 1024 u64 words; run: u32 run count, u16 pairs)
+    vector<uint8_t> serialize() const {
+        vector<uint8_t> out = {'R', 'B', 'M', '1'};
+        put32(out, static_cast<uint32_t>(keys.size()));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const Container& c = containers[i];
+            put16(out, keys[i]);
+            out.push_back(static_cast<uint8_t>(c.kind));
+            put32(out, c.cardinality);
+            if (c.kind == Kind::Run) put32(out, static_cast<uint32_t>(c.values.size() / 2));
+            if (c.kind == Kind::Bitmap) for (uint64_t w : c.words) put64(out, w);
+            else for (uint16_t v : c.values) put16(out, v);
+        }
+        return out;
+    }
+
+    static RoaringBitmap deserialize(const uint8_t* data, size_t size) {
+        Reader in{data, size};
+        if (in.get(4) != 0x314d4252) throw runtime_error("RoaringBitmap: bad magic"); // "RBM1"
+        RoaringBitmap result;
+        size_t chunks = in.get(4);
+        if (chunks > 65536) throw runtime_error("RoaringBitmap: too many chunks");
+        for (size_t i = 0; i < chunks; ++i) {
+            uint16_t key = static_cast<uint16_t>(in.get(2));
+            if (!result.keys.empty() && key <= result.keys.back()) throw runtime_error("RoaringBitmap: chunks out of order");
+            Container c;
+            uint64_t kind = in.get(1);
+            c.cardinality = static_cast<uint32_t>(in.get(4));
+            uint64_t actual = 0;
+            if (kind == uint64_t(Kind::Array)) {
+                if (c.cardinality == 0 || c.cardinality > ArrayMax) throw runtime_error("RoaringBitmap: bad array size");
+                for (uint32_t k = 0; k < c.cardinality; ++k) {
+                    c.values.push_back(static_cast<uint16_t>(in.get(2)));
+                    if (k && c.values[k] <= c.values[k - 1]) throw runtime_error("RoaringBitmap: array not sorted");
+                }
+                actual = c.cardinality;
+            } else if (kind == uint64_t(Kind::Bitmap)) {
+                c.kind = Kind::Bitmap;
+                for (size_t w = 0; w < BitmapWords; ++w) {
+                    c.words.push_back(in.get(8));
+                    actual += popcount(c.words.back());
+                }
+            } else if (kind == uint64_t(Kind::Run)) {
+                c.kind = Kind::Run;
+                size_t runs = in.get(4);
+                if (runs == 0 || runs > 32768) throw runtime_error("RoaringBitmap: bad run count");
+                uint32_t next = 0; // Runs must be ascending and separated by a gap
+                for (size_t r = 0; r < runs; ++r) {
+                    uint32_t start = static_cast<uint32_t>(in.get(2)), length = static_cast<uint32_t>(in.get(2)) + 1;
+                    if ((r && start <= next) || start + length > 65536) throw runtime_error("RoaringBitmap: bad runs");
+                    c.values.push_back(static_cast<uint16_t>(start));
+                    c.values.push_back(static_cast<uint16_t>(length - 1));
+                    next = start + length;
+                    actual += length;
+                }
+            } else {
+                throw runtime_error("RoaringBitmap: unknown container kind");
+            }
+            if (actual != c.cardinality || actual == 0) throw runtime_error("RoaringBitmap: cardinality mismatch");
+            result.append(key, move(c));
+        }
+        if (in.pos != size) throw runtime_error("RoaringBitmap: trailing bytes");
+        return result;
+    }
+};
+
+// Same steps as unorderedSetUsage(), on a roaring bitmap
+void roaringBitmapUsage() {
+    RoaringBitmap us;
+    us.insert(10);
+    us.insert(20);
+    us.insert(10); // Duplicate (will be ignored)
+    us.insert(30);
+    cout << "Roaring bitmap after insertions: ";
+    for (uint32_t n : us) cout << n << " "; // Output: 10 20 30 (always ascending)
+    cout << endl;
+    cout << "Count of 10: " << us.count(10) << endl; // Output: 1
+    cout << "Count of 40: " << us.count(40) << endl; // Output: 0
+    us.erase(20);
+    cout << "Size after removing 20: " << us.size() << endl; // Output: 2
+
+    RoaringBitmap a = {1, 2, 3, 100000}, b = {2, 3, 4, 100000};
+    cout << "a & b: ";
+    for (uint32_t n : a & b) cout << n << " "; // Output: 2 3 100000
+    cout << "\na | b size: " << (a | b).size() << endl; // Output: 5
+    cout << "a - b: ";
+    for (uint32_t n : a - b) cout << n << " "; // Output: 1
+    cout << endl;
+
+    vector<uint8_t> bytes = us.serialize();
+    RoaringBitmap copy = RoaringBitmap::deserialize(bytes.data(), bytes.size());
+    cout << "Round trip equal: " << (copy == us ? "Yes" : "No") << " (" << bytes.size() << " bytes)" << endl;
+    us.clear();
+    cout << "Size after clear: " << us.size() << endl; // Output: 0
+}
+
+// Random operations and set algebra over several densities, compared with set<uint32_t>
+bool roaringBitmapSelfCheck() {
+    mt19937 rng(48);
+    for (uint32_t spread : {100u, 20000u, 200000u, 3000000u, 4294967295u}) {
+        RoaringBitmap a, b;
+        set<uint32_t> sa, sb;
+        for (int i = 0; i < 30000; ++i) {
+            uint32_t x = rng() % spread;
+            if (spread > 100000 && rng() % 2) { // Consecutive stretches, to produce run-friendly chunks
+                bool intoA = rng() % 2;
+                for (uint32_t k = 0; k < 50; ++k) {
+                    if ((intoA ? a : b).insert(x + k) != (intoA ? sa : sb).insert(x + k).second) return false;
+                }
+                continue;
+            }
+            uint32_t op = rng() % 8;
+            if (op < 4) {
+                if (a.insert(x) != sa.insert(x).second) return false;
+            } else if (op < 6) {
+                if (b.insert(x) != sb.insert(x).second) return false;
+            } else if (op == 6) {
+                if (a.erase(x) != sa.erase(x)) return false;
+            } else if (a.count(x) != sa.count(x)) {
+                return false;
+            }
+            if (i == 15000) a.runOptimize(); // Later inserts and erases then hit run containers
+        }
+        if (a.size() != sa.size() || !equal(a.begin(), a.end(), sa.begin(), sa.end())) return false;
+        for (int pass = 0; pass < 2; ++pass) {
+            vector<uint32_t> expected;
+            set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            RoaringBitmap both = a & b;
+            if (!equal(both.begin(), both.end(), expected.begin(), expected.end())) return false;
+            if (RoaringBitmap::andCardinality(a, b) != expected.size()) return false;
+            expected.clear();
+            set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            RoaringBitmap either = a | b;
+            if (either.size() != expected.size() || !equal(either.begin(), either.end(), expected.begin(), expected.end()))
+                return false;
+            expected.clear();
+            set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            RoaringBitmap onlyA = a - b;
+            if (!equal(onlyA.begin(), onlyA.end(), expected.begin(), expected.end())) return false;
+
+            vector<uint8_t> bytes = a.serialize();
+            if (RoaringBitmap::deserialize(bytes.data(), bytes.size()) != a) return false;
+            bytes.pop_back();
+            try {
+                RoaringBitmap::deserialize(bytes.data(), bytes.size());
+                return false;
+            } catch (const runtime_error&) {
+            }
+            a.runOptimize(); // Second pass repeats everything with run containers
+            b.runOptimize();
+        }
+    }
+    return true;
+}
+
+struct AllocationCounter {
+    static size_t bytes;
+};
+size_t AllocationCounter::bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        AllocationCounter::bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        AllocationCounter::bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void roaringBitmapBenchmark() {
+    // Clustered IDs: accounts are allocated in ranges, most of each range is in use
+    const size_t target = 10000000;
+    mt19937 rng(29);
+    auto clustered = [&](size_t n) {
+        vector<uint32_t> ids;
+        while (ids.size() < n) {
+            uint32_t base = rng() % (1u << 28), length = 1000 + rng() % 100000, density = 50 + rng() % 50;
+            for (uint32_t k = 0; k < length && ids.size() < n; ++k)
+                if (rng() % 100 < density) ids.push_back(base + k);
+        }
+        return ids;
+    };
+    vector<uint32_t> a = clustered(target), b = clustered(target);
+    for (uint32_t k = 0; k < 1000000; ++k) { // An overlap, so the sets intersect
+        a.push_back(200000000 + k);
+        b.push_back(200000000 + k);
+    }
+
+    using CountedSet = unordered_set<uint32_t, hash<uint32_t>, equal_to<uint32_t>, CountingAllocator<uint32_t>>;
+    CountedSet ha, hb;
+    RoaringBitmap ra, rb;
+    cout << "\n~" << a.size() << " clustered IDs per set (unordered_set<uint32_t> / RoaringBitmap):\n";
+    double ta = timeMs([&]() {
+        ha.insert(a.begin(), a.end());
+        hb.insert(b.begin(), b.end());
+    });
+    double tb = timeMs([&]() {
+        for (uint32_t x : a) ra.insert(x);
+        for (uint32_t x : b) rb.insert(x);
+        ra.runOptimize();
+        rb.runOptimize();
+    });
+    cout << "  build both:      " << ta << " / " << tb << " ms\n";
+    size_t hashBytes = AllocationCounter::bytes / 2;
+    cout << "  bytes/element:   " << double(hashBytes) / ha.size() << " / " << double(ra.memoryBytes()) / ra.size() << " ("
+         << double(hashBytes) / ra.memoryBytes() << "x smaller, unordered_set excludes malloc headers)\n";
+
+    vector<uint32_t> probes(2000000);
+    for (size_t i = 0; i < probes.size(); ++i) probes[i] = i % 2 ? a[rng() % a.size()] : rng() % (1u << 28);
+    size_t ca = 0, cb = 0;
+    ta = timeMs([&]() { for (uint32_t p : probes) ca += ha.count(p); });
+    tb = timeMs([&]() { for (uint32_t p : probes) cb += ra.count(p); });
+    cout << "  " << probes.size() << " count(): " << ta << " / " << tb << " ms\n";
+
+    size_t common = 0;
+    ta = timeMs([&]() { for (uint32_t x : ha) common += hb.count(x); });
+    RoaringBitmap both;
+    tb = timeMs([&]() { both = ra & rb; });
+    cout << "  intersection:    " << ta << " / " << tb << " ms (" << both.size() << " common)\n";
+    size_t counted = 0;
+    tb = timeMs([&]() { counted = RoaringBitmap::andCardinality(ra, rb); });
+    cout << "  |a & b| only:    " << tb << " ms with andCardinality\n";
+
+    CountedSet merged; // Freed at the end: freeing 20M nodes here would bill malloc's cleanup to the next timing
+    ta = timeMs([&]() {
+        merged = ha;
+        merged.insert(hb.begin(), hb.end());
+    });
+    size_t unionSize = merged.size();
+    RoaringBitmap either;
+    tb = timeMs([&]() { either = ra | rb; });
+    cout << "  union:           " << ta << " / " << tb << " ms (" << either.size() << " total)\n";
+
+    size_t differenceSize = 0;
+    ta = timeMs([&]() { for (uint32_t x : ha) differenceSize += hb.count(x) == 0; });
+    RoaringBitmap onlyA;
+    tb = timeMs([&]() { onlyA = ra - rb; });
+    cout << "  difference:      " << ta << " / " << tb << " ms (" << onlyA.size() << " only in a)\n";
+
+    long long sumA = 0, sumB = 0;
+    ta = timeMs([&]() { for (uint32_t x : ha) sumA += x; });
+    tb = timeMs([&]() { ra.for_each([&](uint32_t x) { sumB += x; }); });
+    cout << "  full scan:       " << ta << " / " << tb << " ms\n";
+
+    vector<uint8_t> bytes;
+    tb = timeMs([&]() { bytes = ra.serialize(); });
+    cout << "  serialize:       " << bytes.size() / (1 << 20) << " MB in " << tb << " ms\n";
+    bool agree = ca == cb && common == both.size() && counted == common && unionSize == either.size() &&
+                 differenceSize == onlyA.size() && sumA == sumB;
+    cout << "  Results agree: " << (agree ? "Yes" : "No") << endl;
+}
+
+int main() {
+    roaringBitmapUsage();
+    cout << "Self-check against set<uint32_t>: " << (roaringBitmapSelfCheck() ? "passed" : "FAILED") << endl;
+    roaringBitmapBenchmark();
+    return 0;
+}
@@ -0,0 +1,317 @@
+#include <iostream>
+#include <unordered_map>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Compile-Time Perfect-Hash Static Map:
+ *
+ * 1. **Problem**:
+ *    - Tables whose keys are fixed at build time (keyword lists, header names, the "Alice" /
+ *      "Bob" / "Charlie" demo maps) are usually built as unordered_map at startup: one malloc
+ *      per entry plus the bucket array, rehashes while filling, and a chained bucket walk on
+ *      every lookup.
+ *
+ * 2. **StaticMap<Key, Value, N>**, built by makeStaticMap<Key, Value>({{key, value}, ...}):
+ *    - makeStaticMap is constexpr: declared `constexpr auto m = makeStaticMap<...>(...)`, the
+ *      whole table is computed by the compiler and placed in read-only data. No startup code,
+ *      no heap, and the map can be used in static_assert.
+ *    - Hash and displace: keys are hashed once, split into buckets of a few keys each, and
+ *      each bucket, largest first, gets the smallest seed that sends all its keys to free
+ *      slots. The result is collision-free, so a lookup is: hash the key, read its bucket's
+ *      seed, compute one slot, compare one key. There is no probe sequence.
+ *    - Capacity is N rounded up to a power of two (the slot is a mask, not a division).
+ *      Unused slots hold a copy of a real key whose own slot is elsewhere, so a lookup never
+ *      needs an "occupied" flag: any other key landing there simply fails the compare.
+ *    - Keys: string_view (pass string literals, std::string or string_view) or any integer type.
+ *      Values must be usable in constant expressions (numbers, enums, string_views, ...).
+ *    - Duplicate keys, or a key set no seed can separate, fail to compile (the builder throws
+ *      during constant evaluation).
+ *    - Operations: find (pointer to value or nullptr), count, contains, at (throws
+ *      out_of_range), size, empty, for_each (declaration order).
+ */
+
+// Hash usable both at compile time and at run time
+struct StaticHash {
+    static constexpr uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    constexpr uint64_t operator()(string_view s) const {
+        uint64_t h = 0xcbf29ce484222325ULL ^ s.size(); // FNV-1a, finished with the mixer
+        for (char c : s) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ULL;
+        }
+        return mix(h);
+    }
+
+    template <typename Int, typename = enable_if_t<is_integral_v<Int>>>
+    constexpr uint64_t operator()(Int x) const { return mix(static_cast<uint64_t>(x) + 0x9e3779b97f4a7c15ULL); }
+};
+
+constexpr size_t staticMapCapacity(size_t n) {
+    size_t c = 1;
+    while (c < n) c <<= 1;
+    return c;
+}
+
+template <typename Key, typename Value, size_t N>
+class StaticMap {
+public:
+    static constexpr size_t Capacity = staticMapCapacity(N);
+    static constexpr size_t Buckets = Capacity >= 4 ? Capacity / 4 : 1; // About 4 keys per bucket
+    static constexpr uint32_t MaxSeed = 1u << 20;
+
+    constexpr explicit StaticMap(const pair<Key, Value> (&entries)[N])
+        : keys{}, values{}, seeds{}, order{} {
+        static_assert(N > 0, "StaticMap needs at least one entry");
+        uint64_t hashes[N]{};
+        size_t bucketSize[Buckets]{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = StaticHash()(entries[i].first);
+            ++bucketSize[bucketOf(hashes[i])];
+        }
+
+        // Members of every bucket, stored contiguously, bucket by bucket
+        size_t bucketStart[Buckets + 1]{};
+        for (size_t b = 0; b < Buckets; ++b) bucketStart[b + 1] = bucketStart[b] + bucketSize[b];
+        size_t members[N]{};
+        size_t fill[Buckets]{};
+        for (size_t i = 0; i < N; ++i) {
+            size_t b = bucketOf(hashes[i]);
+            members[bucketStart[b] + fill[b]++] = i;
+        }
+
+        // Equal keys collide under every seed, so reject them up front
+        for (size_t b = 0; b < Buckets; ++b)
+            for (size_t x = bucketStart[b]; x < bucketStart[b + 1]; ++x)
+                for (size_t y = x + 1; y < bucketStart[b + 1]; ++y)
+                    if (hashes[members[x]] == hashes[members[y]] && entries[members[x]].first == entries[members[y]].first)
+                        throw invalid_argument("StaticMap: duplicate key");
+
+        // Place buckets largest first, while the table still has room to choose from
+        bool used[Capacity]{};
+        size_t slotOfEntry[N]{};
+        for (size_t size = N; size > 0; --size) {
+            for (size_t b = 0; b < Buckets; ++b) {
+                if (bucketSize[b] != size) continue;
+                uint32_t seed = 0;
+                while (!tryPlace(seed, hashes, members + bucketStart[b], size, used, slotOfEntry)) {
+                    if (++seed == MaxSeed) throw logic_error("StaticMap: no collision-free seed found");
+                }
+                seeds[b] = seed;
+            }
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            keys[slotOfEntry[i]] = entries[i].first;
+            values[slotOfEntry[i]] = entries[i].second;
+            order[i] = slotOfEntry[i];
+        }
+        for (size_t s = 0; s < Capacity; ++s)
+            if (!used[s]) keys[s] = entries[0].first; // Entry 0 lives in its own slot, never this one
+    }
+
+    constexpr const Value* find(const Key& key) const {
+        size_t s = slotOf(StaticHash()(key));
+        return keys[s] == key ? &values[s] : nullptr;
+    }
+
+    constexpr size_t count(const Key& key) const { return find(key) ? 1 : 0; }
+    constexpr bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    constexpr const Value& at(const Key& key) const {
+        const Value* v = find(key);
+        if (!v) throw out_of_range("StaticMap::at: key not found");
+        return *v;
+    }
+
+    constexpr size_t size() const { return N; }
+    constexpr bool empty() const { return false; }
+
+    // Calls f(key, value) for every entry, in the order they were given
+    template <typename F>
+    void for_each(F f) const {
+        for (size_t i = 0; i < N; ++i) f(keys[order[i]], values[order[i]]);
+    }
+
+private:
+    Key keys[Capacity];
+    Value values[Capacity];
+    uint32_t seeds[Buckets];
+    size_t order[N]; // Slot of each entry, in declaration order
+
+    static constexpr size_t bucketOf(uint64_t h) { return (h >> 40) & (Buckets - 1); }
+
+    static constexpr size_t slotFor(uint64_t h, uint32_t seed) {
+        return StaticHash::mix(h ^ (seed * 0x9e3779b97f4a7c15ULL)) & (Capacity - 1);
+    }
+
+    constexpr size_t slotOf(uint64_t h) const { return slotFor(h, seeds[bucketOf(h)]); }
+
+    static constexpr bool tryPlace(uint32_t seed, const uint64_t* hashes, const size_t* members, size_t count,
+                                   bool* used, size_t* slotOfEntry) {
+        for (size_t x = 0; x < count; ++x) {
+            size_t s = slotFor(hashes[members[x]], seed);
+            if (used[s]) {
+                for (size_t y = 0; y < x; ++y) used[slotOfEntry[members[y]]] = false; // Undo
+                return false;
+            }
+            used[s] = true;
+            slotOfEntry[members[x]] = s;
+        }
+        return true;
+    }
+};
+
+template <typename Key, typename Value, size_t N>
+constexpr StaticMap<Key, Value, N> makeStaticMap(const pair<Key, Value> (&entries)[N]) {
+    return StaticMap<Key, Value, N>(entries);
+}
+
+// Same data as unorderedMapUsage(), fixed at compile time
+void staticMapUsage() {
+    static constexpr auto ages = makeStaticMap<string_view, int>({{"Alice", 25}, {"Bob", 30}, {"Charlie", 40}});
+    static_assert(ages.at("Bob") == 30, "built and queried by the compiler");
+    static_assert(!ages.contains("Dave"), "missing keys are rejected by the single compare");
+
+    string name = "Alice";
+    cout << "Alice's age: " << *ages.find(name) << endl; // Output: 25
+    cout << "Count of Bob: " << ages.count("Bob") << endl; // Output: 1
+    cout << "Count of Dave: " << ages.count("Dave") << endl; // Output: 0
+    try {
+        ages.at("Dave");
+    } catch (const out_of_range& e) {
+        cout << "Exception: " << e.what() << endl; // Output: Exception: StaticMap::at: key not found
+    }
+    cout << "Static map: ";
+    ages.for_each([](string_view k, int v) { cout << k << "=" << v << " "; }); // Output: Alice=25 Bob=30 Charlie=40
+    cout << endl;
+
+    // Integer keys work the same way
+    static constexpr auto httpReasons = makeStaticMap<int, string_view>(
+        {{200, "OK"}, {201, "Created"}, {301, "Moved Permanently"}, {404, "Not Found"}, {500, "Internal Server Error"}});
+    cout << "404: " << httpReasons.at(404) << endl; // Output: 404: Not Found
+    cout << "Size of static map: " << httpReasons.size() << endl; // Output: 5
+}
+
+// The 48 keywords of C++98 plus the C++11 additions: a typical fixed table
+static constexpr pair<string_view, int> keywordEntries[] = {
+    {"alignas", 0}, {"alignof", 1}, {"asm", 2}, {"auto", 3}, {"bool", 4}, {"break", 5}, {"case", 6},
+    {"catch", 7}, {"char", 8}, {"char16_t", 9}, {"char32_t", 10}, {"class", 11}, {"const", 12},
+    {"constexpr", 13}, {"const_cast", 14}, {"continue", 15}, {"decltype", 16}, {"default", 17},
+    {"delete", 18}, {"do", 19}, {"double", 20}, {"dynamic_cast", 21}, {"else", 22}, {"enum", 23},
+    {"explicit", 24}, {"export", 25}, {"extern", 26}, {"false", 27}, {"float", 28}, {"for", 29},
+    {"friend", 30}, {"goto", 31}, {"if", 32}, {"inline", 33}, {"int", 34}, {"long", 35},
+    {"mutable", 36}, {"namespace", 37}, {"new", 38}, {"noexcept", 39}, {"nullptr", 40},
+    {"operator", 41}, {"private", 42}, {"protected", 43}, {"public", 44}, {"register", 45},
+    {"reinterpret_cast", 46}, {"return", 47}, {"short", 48}, {"signed", 49}, {"sizeof", 50},
+    {"static", 51}, {"static_assert", 52}, {"static_cast", 53}, {"struct", 54}, {"switch", 55},
+    {"template", 56}, {"this", 57}, {"thread_local", 58}, {"throw", 59}, {"true", 60}, {"try", 61},
+    {"typedef", 62}, {"typeid", 63}, {"typename", 64}, {"union", 65}, {"unsigned", 66},
+    {"using", 67}, {"virtual", 68}, {"void", 69}, {"volatile", 70}, {"wchar_t", 71}, {"while", 72},
+};
+
+static constexpr auto keywords = makeStaticMap(keywordEntries);
+
+// Looks up every keyword and a set of non-keywords, comparing the answers with unordered_map
+bool staticMapSelfCheck() {
+    unordered_map<string, int> expected;
+    for (auto& e : keywordEntries) expected.emplace(e.first, e.second);
+    for (auto& e : keywordEntries) {
+        const int* v = keywords.find(e.first);
+        if (!v || *v != e.second) return false;
+    }
+    mt19937 rng(45);
+    for (int i = 0; i < 100000; ++i) {
+        string s;
+        size_t len = 1 + rng() % 12;
+        for (size_t j = 0; j < len; ++j) s += static_cast<char>('a' + rng() % 26);
+        auto it = expected.find(s);
+        const int* v = keywords.find(s);
+        if ((it == expected.end()) != (v == nullptr)) return false;
+        if (v && *v != it->second) return false;
+    }
+    size_t seen = 0;
+    keywords.for_each([&](string_view k, int v) { seen += keywordEntries[v].first == k; });
+    return seen == keywords.size();
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void staticMapBenchmark() {
+    const size_t lookups = 5000000;
+    mt19937 rng(7);
+
+    // Identifiers as a lexer sees them: about half keywords, half user names
+    vector<string> pool;
+    for (auto& e : keywordEntries) pool.emplace_back(e.first);
+    for (const char* id : {"value", "count", "index", "buffer", "result", "node", "left", "right", "size", "key"})
+        pool.emplace_back(id);
+    for (int i = 0; pool.size() < 2 * size(keywordEntries); ++i) pool.push_back("var" + to_string(i));
+    vector<string_view> tokens;
+    for (size_t i = 0; i < lookups; ++i) tokens.push_back(pool[rng() % pool.size()]);
+
+    unordered_map<string, int> hashed;
+    map<string, int, less<>> tree;
+    double hashedBuild = timeMs([&]() {
+        for (auto& e : keywordEntries) hashed.emplace(e.first, e.second);
+    });
+    double treeBuild = timeMs([&]() {
+        for (auto& e : keywordEntries) tree.emplace(e.first, e.second);
+    });
+
+    long long sa = 0, sb = 0, sc = 0;
+    double staticTime = timeMs([&]() {
+        for (auto t : tokens) if (const int* v = keywords.find(t)) sa += *v + 1;
+    });
+    double hashedTime = timeMs([&]() {
+        for (auto t : tokens) {
+            auto it = hashed.find(string(t));
+            if (it != hashed.end()) sb += it->second + 1;
+        }
+    });
+    double treeTime = timeMs([&]() {
+        for (auto t : tokens) {
+            auto it = tree.find(t);
+            if (it != tree.end()) sc += it->second + 1;
+        }
+    });
+
+    cout << "\n" << size(keywordEntries) << " keywords, " << lookups << " lookups (about half misses):\n";
+    cout << "  Startup: StaticMap 0 ms (built by the compiler, " << sizeof(keywords) << " bytes of read-only data)"
+         << ", unordered_map " << hashedBuild << " ms, map " << treeBuild << " ms\n";
+    cout << "  StaticMap::find:      " << staticTime << " ms\n";
+    cout << "  unordered_map::find:  " << hashedTime << " ms\n";
+    cout << "  map::find:            " << treeTime << " ms\n";
+    cout << "  Results agree: " << (sa == sb && sb == sc ? "Yes" : "No") << endl;
+}
+
+int main() {
+    staticMapUsage();
+    cout << "Static map self-check: " << (staticMapSelfCheck() ? "passed" : "FAILED") << endl;
+    staticMapBenchmark();
+    return 0;
+}
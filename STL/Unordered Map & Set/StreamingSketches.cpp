@@ -0,0 +1,563 @@
+#include <iostream>
+#include <iomanip>
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Streaming Sketches: Count-Min, Heavy Hitters and HyperLogLog:
+ *
+ * 1. **Problem**:
+ *    - Counting events with unordered_map<string, int> and distinct keys with unordered_set::size()
+ *      costs a node per distinct key. At billions of events with hundreds of millions of distinct
+ *      keys the exact structures no longer fit in memory, even though most questions only need
+ *      "about how many" and "which keys are the biggest".
+ *
+ * 2. **CountMinSketch<Key>(epsilon, delta)**: approximate per-key counts in fixed memory.
+ *    - depth = ceil(ln(1/delta)) rows of width = e/epsilon counters (rounded up to a power of
+ *      two); add(key) increments one counter per row, estimate(key) takes the minimum.
+ *    - Guarantee: the estimate never undercounts, and exceeds the true count by more than
+ *      epsilon * totalCount() with probability at most delta.
+ *
+ * 3. **HeavyHitters<Key>(k, epsilon, delta)**: a Count-Min sketch plus the k keys with the largest
+ *    estimates seen so far; top() lists them, largest first. Any key whose true count exceeds
+ *    totalCount() / k (plus the sketch error) is guaranteed to be among them.
+ *
+ * 4. **HyperLogLog<Key>(precision)**: approximate distinct count in 2^precision bytes.
+ *    - Each key's hash picks a register and records the longest run of leading zeros seen there.
+ *      The estimate uses Ertl's improved estimator, accurate from 0 up to billions without the
+ *      bias tables of HyperLogLog++. Standard error 1.04 / sqrt(2^precision): 0.8% at precision 14
+ *      (16 KB), whatever the cardinality.
+ *
+ * 5. **Merging**: every sketch has merge(other), so each thread can fill its own sketch and the
+ *    results are combined at the end, with no shared state while counting. Count-Min merges add
+ *    counters and HyperLogLog merges take register maxima, 2 and 16 registers per SSE2 instruction
+ *    respectively; for these two the merged sketch is identical to one built from the whole
+ *    stream. HeavyHitters merges its Count-Min sketch exactly but re-ranks only the union of each
+ *    side's candidates, so its top() can differ from a single-stream run (heavy keys still make
+ *    it). Sketches must have the same dimensions and seed (merge throws invalid_argument otherwise).
+ */
+
+// std::hash is the identity for integers: mix it so every bit of the 64-bit hash is usable
+template <typename Key>
+struct SketchHash {
+    uint64_t operator()(const Key& key, uint64_t seed) const {
+        uint64_t x = hash<Key>()(key) ^ seed;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+template <typename Key, typename Hash = SketchHash<Key>>
+class CountMinSketch {
+public:
+    CountMinSketch(double epsilon, double delta, uint64_t seed = 0x5eed)
+        : width(1), depth(static_cast<size_t>(ceil(log(1.0 / delta)))), seed(seed), total(0) {
+        if (epsilon <= 0 || epsilon >= 1 || delta <= 0 || delta >= 1) throw invalid_argument("CountMinSketch: epsilon and delta must be in (0, 1)");
+        while (width < exp(1.0) / epsilon) width <<= 1;
+        depth = max<size_t>(depth, 1);
+        counters.assign(width * depth, 0);
+    }
+
+    void add(const Key& key, uint64_t count = 1) {
+        uint64_t h = hasher(key, seed);
+        for (size_t row = 0; row < depth; ++row) counters[cell(h, row)] += count;
+        total += count;
+    }
+
+    // Adds and returns the new estimate in one pass over the rows
+    uint64_t addAndEstimate(const Key& key, uint64_t count = 1) {
+        uint64_t h = hasher(key, seed), estimate = UINT64_MAX;
+        for (size_t row = 0; row < depth; ++row) estimate = min(estimate, counters[cell(h, row)] += count);
+        total += count;
+        return estimate;
+    }
+
+    uint64_t estimate(const Key& key) const {
+        uint64_t h = hasher(key, seed), estimate = UINT64_MAX;
+        for (size_t row = 0; row < depth; ++row) estimate = min(estimate, counters[cell(h, row)]);
+        return estimate;
+    }
+
+    void merge(const CountMinSketch& other) {
+        if (width != other.width || depth != other.depth || seed != other.seed)
+            throw invalid_argument("CountMinSketch: merging sketches of different shape");
+        uint64_t* a = counters.data();
+        const uint64_t* b = other.counters.data();
+        size_t n = counters.size(), i = 0;
+#ifdef __SSE2__
+        for (; i + 2 <= n; i += 2) {
+            __m128i sum = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), sum);
+        }
+#endif
+        for (; i < n; ++i) a[i] += b[i];
+        total += other.total;
+    }
+
+    void clear() {
+        fill(counters.begin(), counters.end(), 0);
+        total = 0;
+    }
+
+    uint64_t totalCount() const { return total; }
+    size_t memoryBytes() const { return counters.size() * sizeof(uint64_t); }
+    bool operator==(const CountMinSketch& other) const { return total == other.total && counters == other.counters; }
+
+private:
+    size_t width; // Power of two
+    size_t depth;
+    uint64_t seed;
+    uint64_t total;
+    vector<uint64_t> counters; // depth rows of width counters
+    Hash hasher;
+
+    // Row i uses h1 + i * h2 (double hashing): one 64-bit hash serves every row
+    size_t cell(uint64_t h, size_t row) const {
+        uint64_t h1 = h & 0xffffffff, h2 = (h >> 32) | 1;
+        return row * width + ((h1 + row * h2) & (width - 1));
+    }
+};
+
+template <typename Key, typename Hash = SketchHash<Key>>
+class HeavyHitters {
+public:
+    HeavyHitters(size_t k, double epsilon, double delta, uint64_t seed = 0x5eed)
+        : k(k), sketch(epsilon, delta, seed), smallest(0), atSmallest(0) {}
+
+    void add(const Key& key, uint64_t count = 1) {
+        uint64_t estimate = sketch.addAndEstimate(key, count);
+        auto it = candidates.find(key);
+        if (it != candidates.end()) {
+            bool leavesBar = candidates.size() == k && it->second == smallest && estimate != smallest;
+            it->second = estimate;
+            if (leavesBar && --atSmallest == 0) refreshSmallest(); // The last candidate at the bar moved up
+        } else if (candidates.size() < k) {
+            candidates.emplace(key, estimate);
+            refreshSmallest();
+        } else if (k > 0 && estimate > smallest) { // Evict the weakest candidate; rare once the top k settle
+            auto victim = candidates.begin();
+            while (victim->second != smallest) ++victim;
+            candidates.erase(victim);
+            candidates.emplace(key, estimate);
+            refreshSmallest();
+        }
+    }
+
+    void merge(const HeavyHitters& other) {
+        sketch.merge(other.sketch);
+        vector<Key> keys;
+        for (auto& c : candidates) keys.push_back(c.first);
+        for (auto& c : other.candidates) keys.push_back(c.first);
+        candidates.clear();
+        for (auto& key : keys) candidates[key] = sketch.estimate(key); // Re-estimate from the merged counts
+        if (candidates.size() > k) {
+            vector<pair<Key, uint64_t>> ranked(candidates.begin(), candidates.end());
+            nth_element(ranked.begin(), ranked.begin() + k, ranked.end(),
+                        [](const pair<Key, uint64_t>& a, const pair<Key, uint64_t>& b) { return a.second > b.second; });
+            candidates = unordered_map<Key, uint64_t>(ranked.begin(), ranked.begin() + k);
+        }
+        refreshSmallest();
+    }
+
+    // The tracked keys with their estimated counts, largest first
+    vector<pair<Key, uint64_t>> top() const {
+        vector<pair<Key, uint64_t>> result(candidates.begin(), candidates.end());
+        sort(result.begin(), result.end(), [](const pair<Key, uint64_t>& a, const pair<Key, uint64_t>& b) { return a.second > b.second; });
+        return result;
+    }
+
+    uint64_t estimate(const Key& key) const { return sketch.estimate(key); }
+    uint64_t totalCount() const { return sketch.totalCount(); }
+    const CountMinSketch<Key, Hash>& counts() const { return sketch; }
+
+private:
+    size_t k;
+    CountMinSketch<Key, Hash> sketch;
+    unordered_map<Key, uint64_t> candidates;
+    uint64_t smallest; // Smallest candidate estimate once k are tracked: the bar a newcomer must pass
+    size_t atSmallest; // Candidates whose estimate equals smallest; the bar only moves when this hits 0
+
+    // O(k), but only needed when the bar moves
+    void refreshSmallest() {
+        smallest = 0;
+        atSmallest = 0;
+        if (candidates.size() < k) return;
+        smallest = UINT64_MAX;
+        for (auto& c : candidates) {
+            if (c.second < smallest) {
+                smallest = c.second;
+                atSmallest = 0;
+            }
+            atSmallest += c.second == smallest;
+        }
+    }
+};
+
+template <typename Key, typename Hash = SketchHash<Key>>
+class HyperLogLog {
+public:
+    explicit HyperLogLog(unsigned precision = 14, uint64_t seed = 0x5eed) : precision(precision), seed(seed) {
+        if (precision < 4 || precision > 18) throw invalid_argument("HyperLogLog: precision must be in [4, 18]");
+        registers.assign(size_t(1) << precision, 0);
+    }
+
+    void add(const Key& key) {
+        uint64_t h = hasher(key, seed);
+        size_t index = h >> (64 - precision);
+        uint64_t rest = (h << precision) | (uint64_t(1) << (precision - 1)); // Guard bit caps the rank at 65 - precision
+        uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+        if (rank > registers[index]) registers[index] = rank;
+    }
+
+    double estimate() const {
+        const size_t m = registers.size();
+        const unsigned q = 64 - precision;
+        vector<size_t> histogram(q + 2, 0);
+        for (uint8_t r : registers) ++histogram[r];
+        double z = m * tau(1.0 - double(histogram[q + 1]) / m);
+        for (size_t k = q; k >= 1; --k) z = 0.5 * (z + histogram[k]);
+        z += m * sigma(double(histogram[0]) / m);
+        return m * m / (2 * log(2.0)) / z;
+    }
+
+    void merge(const HyperLogLog& other) {
+        if (precision != other.precision || seed != other.seed) throw invalid_argument("HyperLogLog: merging sketches of different shape");
+        uint8_t* a = registers.data();
+        const uint8_t* b = other.registers.data();
+        size_t n = registers.size(), i = 0;
+#ifdef __SSE2__
+        for (; i + 16 <= n; i += 16) {
+            __m128i x = _mm_max_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), x);
+        }
+#endif
+        for (; i < n; ++i) a[i] = max(a[i], b[i]);
+    }
+
+    void clear() { fill(registers.begin(), registers.end(), 0); }
+    size_t memoryBytes() const { return registers.size(); }
+    double standardError() const { return 1.04 / sqrt(double(registers.size())); }
+    bool operator==(const HyperLogLog& other) const { return registers == other.registers; }
+
+private:
+    unsigned precision;
+    uint64_t seed;
+    vector<uint8_t> registers;
+    Hash hasher;
+
+    // Correction terms of Ertl's estimator for empty (sigma) and saturated (tau) registers
+    static double sigma(double x) {
+        if (x == 1) return INFINITY;
+        double y = 1, z = x, previous;
+        do {
+            x *= x;
+            previous = z;
+            z += x * y;
+            y += y;
+        } while (z != previous);
+        return z;
+    }
+
+    static double tau(double x) {
+        if (x == 0 || x == 1) return 0;
+        double y = 1, z = 1 - x, previous;
+        do {
+            x = sqrt(x);
+            previous = z;
+            y *= 0.5;
+            z -= (1 - x) * (1 - x) * y;
+        } while (z != previous);
+        return z / 3;
+    }
+};
+
+// The demo's counting patterns: word counts with unordered_map, distinct counts with unordered_set
+void streamingSketchesUsage() {
+    vector<string> events = {"Alice", "Bob", "Alice", "Charlie", "Alice", "Bob"};
+    HeavyHitters<string> hitters(2, 0.01, 0.01);
+    HyperLogLog<string> distinct(12);
+    for (auto& e : events) {
+        hitters.add(e);
+        distinct.add(e);
+    }
+    cout << "Estimated count of Alice: " << hitters.estimate("Alice") << endl; // Output: 3
+    cout << "Top 2: ";
+    for (auto& [name, count] : hitters.top()) cout << name << "=" << count << " "; // Output: Alice=3 Bob=2
+    cout << endl;
+    cout << "Estimated distinct names: " << lround(distinct.estimate()) << endl; // Output: 3
+
+    // Two threads' HyperLogLogs merged equal one sketch over both streams
+    HyperLogLog<int> left(12), right(12), both(12);
+    for (int i = 0; i < 1000; ++i) {
+        (i % 2 ? left : right).add(i);
+        both.add(i);
+    }
+    left.merge(right);
+    cout << "Merged equals whole: " << (left == both ? "Yes" : "No") << endl; // Output: Yes
+}
+
+// Samples ranks 0..n-1 with probability proportional to 1 / (rank + 1)^s
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double s) : cdf(n) {
+        double sum = 0;
+        for (size_t i = 0; i < n; ++i) cdf[i] = sum += 1.0 / pow(double(i + 1), s);
+        for (double& c : cdf) c /= sum;
+    }
+
+    template <typename Rng>
+    size_t operator()(Rng& rng) const {
+        double u = uniform_real_distribution<double>(0, 1)(rng);
+        return min<size_t>(lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin(), cdf.size() - 1);
+    }
+
+private:
+    vector<double> cdf;
+};
+
+// Error bounds against exact containers, and thread merges against single-threaded sketches
+bool streamingSketchesSelfCheck() {
+    bool passed = true;
+    mt19937_64 rng(50);
+    const size_t keys = 200000, events = 2000000;
+    ZipfSampler zipf(keys, 1.05);
+    vector<string> names;
+    for (size_t i = 0; i < keys; ++i) names.push_back("event-" + to_string(i));
+    vector<uint32_t> stream(events);
+    for (auto& e : stream) e = static_cast<uint32_t>(zipf(rng));
+
+    unordered_map<string, uint64_t> exact;
+    for (uint32_t e : stream) ++exact[names[e]];
+
+    cout << "\nCount-Min error over " << events << " Zipf events, " << exact.size() << " distinct keys:\n";
+    cout << "  epsilon   delta    bytes   undercounts   over eps*N (allowed)   max error\n";
+    for (auto [epsilon, delta] : {pair<double, double>{0.001, 0.01}, {0.0001, 0.001}}) {
+        CountMinSketch<string> cms(epsilon, delta);
+        for (uint32_t e : stream) cms.add(names[e]);
+        size_t under = 0, beyond = 0;
+        uint64_t worst = 0;
+        for (auto& [key, count] : exact) {
+            uint64_t estimate = cms.estimate(key);
+            under += estimate < count;
+            beyond += estimate - count > epsilon * events;
+            worst = max(worst, estimate - count);
+        }
+        double beyondRate = double(beyond) / exact.size();
+        passed = passed && under == 0 && beyondRate <= delta;
+        cout << "  " << setw(7) << epsilon << setw(8) << delta << setw(9) << cms.memoryBytes() << setw(14) << under
+             << setw(11) << fixed << setprecision(5) << beyondRate << " (" << delta << ")" << defaultfloat
+             << setprecision(6) << setw(12) << worst << "\n";
+    }
+
+    // Heavy hitters: the exact top 20 must all be reported
+    const size_t k = 20;
+    vector<pair<string, uint64_t>> exactTop(exact.begin(), exact.end());
+    sort(exactTop.begin(), exactTop.end(), [](const pair<string, uint64_t>& a, const pair<string, uint64_t>& b) { return a.second > b.second; });
+    exactTop.resize(k);
+    HeavyHitters<string> hitters(k, 0.0005, 0.001);
+    for (uint32_t e : stream) hitters.add(names[e]);
+    auto reported = hitters.top();
+    size_t found = 0;
+    for (auto& [key, count] : exactTop)
+        found += any_of(reported.begin(), reported.end(), [&](const pair<string, uint64_t>& r) { return r.first == key; });
+    passed = passed && found == k;
+    cout << "  Top " << k << " recall: " << found << "/" << k << " (largest: " << reported[0].first << " ~" << reported[0].second
+         << ", exact " << exactTop[0].second << ")\n";
+
+    // A candidate that grows while it sits at the bar must raise the bar: B must not lose to C
+    HeavyHitters<string> twoKeys(2, 0.001, 0.001);
+    for (const char* key : {"A", "B"})
+        for (int i = 0; i < 10; ++i) twoKeys.add(key);
+    twoKeys.add("C", 2);
+    auto topTwo = twoKeys.top();
+    bool barMoves = topTwo.size() == 2 && topTwo[0].second == 10 && topTwo[1].second == 10;
+    passed = passed && barMoves;
+    cout << "  Top 2 of A x10, B x10, C x2: ";
+    for (auto& [key, count] : topTwo) cout << key << "=" << count << " ";
+    cout << (barMoves ? "" : "(wrong)") << "\n";
+
+    // HyperLogLog against unordered_set::size()
+    cout << "\nHyperLogLog relative error against unordered_set::size() (bound: 3 standard errors):\n";
+    cout << "  distinct    p=10 (1 KB)   p=14 (16 KB)\n";
+    for (size_t n : {10, 100, 1000, 10000, 100000, 1000000, 3000000}) {
+        unordered_set<uint64_t> exactSet;
+        HyperLogLog<uint64_t> small(10), large(14);
+        for (size_t i = 0; exactSet.size() < n; ++i) {
+            uint64_t id = rng();
+            exactSet.insert(id);
+            small.add(id);
+            large.add(id);
+        }
+        double errSmall = small.estimate() / exactSet.size() - 1, errLarge = large.estimate() / exactSet.size() - 1;
+        passed = passed && fabs(errSmall) <= 3 * small.standardError() && fabs(errLarge) <= 3 * large.standardError();
+        cout << fixed << setprecision(2) << setw(10) << n << setw(12) << 100 * errSmall << "%" << setw(13) << 100 * errLarge << "%"
+             << defaultfloat << setprecision(6) << "\n";
+    }
+
+    // Thread-local sketches merged must equal one sketch over the whole stream
+    const size_t threads = 4;
+    vector<CountMinSketch<string>> partCms(threads, CountMinSketch<string>(0.001, 0.01));
+    vector<HyperLogLog<string>> partHll(threads, HyperLogLog<string>(14));
+    vector<HeavyHitters<string>> partTop(threads, HeavyHitters<string>(k, 0.0005, 0.001));
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = t; i < events; i += threads) {
+                partCms[t].add(names[stream[i]]);
+                partHll[t].add(names[stream[i]]);
+                partTop[t].add(names[stream[i]]);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    CountMinSketch<string> wholeCms(0.001, 0.01);
+    HyperLogLog<string> wholeHll(14);
+    for (uint32_t e : stream) {
+        wholeCms.add(names[e]);
+        wholeHll.add(names[e]);
+    }
+    for (size_t t = 1; t < threads; ++t) {
+        partCms[0].merge(partCms[t]);
+        partHll[0].merge(partHll[t]);
+        partTop[0].merge(partTop[t]);
+    }
+    auto mergedTop = partTop[0].top();
+    size_t mergedFound = 0;
+    for (auto& [key, count] : exactTop)
+        mergedFound += any_of(mergedTop.begin(), mergedTop.end(), [&](const pair<string, uint64_t>& r) { return r.first == key; });
+    bool mergesAgree = partCms[0] == wholeCms && partHll[0] == wholeHll;
+    passed = passed && mergesAgree && mergedFound == k;
+    cout << "\n" << threads << " thread-local Count-Min and HyperLogLog sketches merged equal the single-stream ones: "
+         << (mergesAgree ? "Yes" : "No") << " (distinct estimate " << lround(partHll[0].estimate()) << ", exact " << exact.size() << ")\n";
+    cout << "  Merged top " << k << " recall: " << mergedFound << "/" << k << "\n";
+    return passed;
+}
+
+struct AllocationCounter {
+    static size_t bytes;
+};
+size_t AllocationCounter::bytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        AllocationCounter::bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        AllocationCounter::bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void streamingSketchesBenchmark() {
+    const size_t keys = 2000000, events = 10000000;
+    mt19937_64 rng(8);
+    ZipfSampler zipf(keys, 0.9); // A long tail: most keys are seen only a few times
+    vector<uint64_t> stream(events);
+    for (auto& e : stream) e = zipf(rng) * 0x9e3779b97f4a7c15ULL; // Spread-out 64-bit IDs
+
+    using CountedMap = unordered_map<uint64_t, uint64_t, hash<uint64_t>, equal_to<uint64_t>, CountingAllocator<pair<const uint64_t, uint64_t>>>;
+    using CountedSet = unordered_set<uint64_t, hash<uint64_t>, equal_to<uint64_t>, CountingAllocator<uint64_t>>;
+    CountedMap counts;
+    CountedSet distinct;
+    double exactTime = timeMs([&]() {
+        for (uint64_t e : stream) {
+            ++counts[e];
+            distinct.insert(e);
+        }
+    });
+    size_t exactBytes = AllocationCounter::bytes;
+
+    HeavyHitters<uint64_t> hitters(100, 0.0001, 0.001);
+    HyperLogLog<uint64_t> hll(14);
+    double sketchTime = timeMs([&]() {
+        for (uint64_t e : stream) {
+            hitters.add(e);
+            hll.add(e);
+        }
+    });
+
+    // The same work split over threads, each with its own sketches, merged at the end
+    const size_t threads = 4;
+    vector<HeavyHitters<uint64_t>> partTop(threads, HeavyHitters<uint64_t>(100, 0.0001, 0.001));
+    vector<HyperLogLog<uint64_t>> partHll(threads, HyperLogLog<uint64_t>(14));
+    double mergeTime = 0;
+    double parallelTime = timeMs([&]() {
+        vector<thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                size_t begin = events * t / threads, end = events * (t + 1) / threads;
+                for (size_t i = begin; i < end; ++i) {
+                    partTop[t].add(stream[i]);
+                    partHll[t].add(stream[i]);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        mergeTime = timeMs([&]() {
+            for (size_t t = 1; t < threads; ++t) {
+                partTop[0].merge(partTop[t]);
+                partHll[0].merge(partHll[t]);
+            }
+        });
+    });
+
+    uint64_t topKey = hitters.top()[0].first;
+    cout << "\n" << events << " events over " << distinct.size() << " distinct 64-bit keys:\n";
+    cout << "  unordered_map + unordered_set:  " << exactTime << " ms, " << exactBytes / (1 << 20) << " MB\n";
+    cout << "  HeavyHitters(100) + HyperLogLog: " << sketchTime << " ms, "
+         << (hitters.counts().memoryBytes() + hll.memoryBytes()) / 1024 << " KB (plus 100 tracked keys)\n";
+    cout << "  " << threads << " threads + merge:               " << parallelTime << " ms (merge " << mergeTime << " ms)\n";
+    cout << "  Distinct: exact " << distinct.size() << ", estimated " << lround(hll.estimate()) << ", merged "
+         << lround(partHll[0].estimate()) << "\n";
+    cout << "  Top key: exact " << counts[topKey] << ", estimated " << hitters.estimate(topKey) << ", merged "
+         << partTop[0].estimate(topKey) << endl;
+}
+
+int main() {
+    streamingSketchesUsage();
+    bool passed = streamingSketchesSelfCheck();
+    cout << "Sketch error-bound self-check: " << (passed ? "passed" : "FAILED") << endl;
+    streamingSketchesBenchmark();
+    return 0;
+}
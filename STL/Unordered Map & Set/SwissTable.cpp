@@ -0,0 +1,576 @@
+#include <iostream>
+#include <unordered_set>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <new>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * Swiss-Table Style Hash Set and Map:
+ *
+ * 1. **Problem**:
+ *    - unordered_set / unordered_map allocate a node per element and chain nodes per bucket,
+ *      so every insert calls malloc and every lookup follows at least two pointers.
+ *
+ * 2. **SwissSet<Key, Hash, Equal>** and **SwissMap<Key, Value, Hash, Equal>**:
+ *    - Open addressing: elements live directly in one slot array, grouped 16 slots at a time.
+ *    - Each slot has a 1-byte control entry: 0 for empty, or 0x80 | 7 bits of the hash. A probe
+ *      loads a group's 16 control bytes and compares them all against the wanted 7 bits with one
+ *      SSE2 instruction, so only slots whose hash bits match (about 1 in 128 false hits) have
+ *      their keys compared.
+ *    - Groups are probed in triangular order (start, +1, +3, +6, ...), which visits every group.
+ *    - Tombstone-free erase: every group counts how many elements overflowed past it because it
+ *      was full when they were inserted. A lookup stops at the first group with a zero overflow
+ *      count; erase decrements the counts along the erased element's probe path. Erased slots
+ *      become plain empty slots, so insert/erase churn leaves no tombstones behind.
+ *    - A count stops at 255 and can then no longer be decremented, so it would keep misses probing
+ *      past that group. Once an erase meets such a count and 1/8 of the capacity has been erased
+ *      since the last rebuild, the next insert rehashes in place to recount (amortized O(1)).
+ *    - Maximum load factor 7/8; the table doubles when it would be exceeded.
+ *    - Operations (same as the demos): insert, emplace, count, find, erase(key), erase(iterator),
+ *      clear, size, empty, begin/end, bucket_count, load_factor, reserve, operator[] (map).
+ *    - Like any open-addressing table, rehashing moves elements: iterators and references are
+ *      invalidated by inserts that grow the table.
+ */
+
+// Shared open-addressing core; KeyOf extracts the key from a stored element
+template <typename Element, typename Key, typename KeyOf, typename Hash, typename Equal>
+class SwissBase {
+protected:
+    static constexpr size_t GroupSize = 16;
+    static constexpr uint8_t Empty = 0;
+    static constexpr uint8_t OverflowSaturated = 255; // Stuck until the next rehash once reached
+
+    uint8_t* ctrl;     // GroupSize control bytes per group
+    uint8_t* overflow; // Per group: elements that probed past it
+    Element* slots;
+    size_t groupMask;  // groups - 1 (groups is a power of two), unused while slots == nullptr
+    size_t elements;
+    size_t erasedSinceRehash;
+    bool staleOverflow; // An erase passed a saturated count, which now overstates its group
+    Hash hasher;
+    Equal equal;
+
+    size_t groups() const { return slots ? groupMask + 1 : 0; }
+    size_t capacity() const { return groups() * GroupSize; }
+
+    // Spreads weak hashes such as the identity hash for ints over all bits
+    uint64_t mix(const Key& key) const {
+        uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 29);
+    }
+
+    static uint8_t tagOf(uint64_t h) { return static_cast<uint8_t>(0x80 | (h & 0x7F)); }
+    size_t startGroup(uint64_t h) const { return (h >> 7) & groupMask; }
+
+    // Bit i set if control byte i of group g equals tag
+    unsigned matchTag(size_t g, uint8_t tag) const {
+        const uint8_t* c = ctrl + g * GroupSize;
+#ifdef __SSE2__
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag)))));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i) mask |= unsigned(c[i] == tag) << i;
+        return mask;
+#endif
+    }
+
+    unsigned matchEmpty(size_t g) const { return matchTag(g, Empty); }
+
+#ifdef __SSE2__
+    // Full slots have the top bit set, so movemask reads them directly
+    unsigned matchFull(size_t g) const {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + g * GroupSize))));
+    }
+#else
+    unsigned matchFull(size_t g) const { return ~matchEmpty(g) & 0xFFFF; }
+#endif
+
+    // Slot index of key, or SIZE_MAX
+    size_t findIndex(const Key& key) const {
+        if (!slots) return SIZE_MAX;
+        uint64_t h = mix(key);
+        uint8_t tag = tagOf(h);
+        size_t g = startGroup(h);
+        for (size_t step = 1; step <= groups(); ++step) {
+            for (unsigned m = matchTag(g, tag); m; m &= m - 1) {
+                size_t i = g * GroupSize + __builtin_ctz(m);
+                if (equal(KeyOf()(slots[i]), key)) return i;
+            }
+            if (overflow[g] == 0) return SIZE_MAX; // Nothing with this start group went further
+            g = (g + step) & groupMask;
+        }
+        return SIZE_MAX;
+    }
+
+    // Places an element known to be absent; the table must have room
+    size_t placeNew(uint64_t h, Element&& element) {
+        size_t g = startGroup(h);
+        for (size_t step = 1;; ++step) {
+            unsigned empty = matchEmpty(g);
+            if (empty) {
+                size_t i = g * GroupSize + __builtin_ctz(empty);
+                ctrl[i] = tagOf(h);
+                new (slots + i) Element(move(element));
+                ++elements;
+                return i;
+            }
+            if (overflow[g] != OverflowSaturated) ++overflow[g];
+            g = (g + step) & groupMask;
+        }
+    }
+
+    void allocate(size_t groupCount) {
+        groupMask = groupCount - 1;
+        ctrl = new uint8_t[groupCount * GroupSize]();
+        overflow = new uint8_t[groupCount]();
+        slots = static_cast<Element*>(::operator new(groupCount * GroupSize * sizeof(Element)));
+        erasedSinceRehash = 0;
+        staleOverflow = false;
+    }
+
+    void release() {
+        if (!slots) return;
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] != Empty) slots[i].~Element();
+        }
+        delete[] ctrl;
+        delete[] overflow;
+        ::operator delete(slots);
+        slots = nullptr;
+        ctrl = overflow = nullptr;
+        elements = 0;
+    }
+
+    void rehashTo(size_t groupCount) {
+        uint8_t* oldCtrl = ctrl;
+        uint8_t* oldOverflow = overflow;
+        Element* oldSlots = slots;
+        size_t oldCapacity = capacity();
+        allocate(groupCount);
+        elements = 0;
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] == Empty) continue;
+            placeNew(mix(KeyOf()(oldSlots[i])), move(oldSlots[i]));
+            oldSlots[i].~Element();
+        }
+        delete[] oldCtrl;
+        delete[] oldOverflow;
+        ::operator delete(oldSlots);
+    }
+
+    // Makes room for one more element under the 7/8 load limit, or recounts stale overflow
+    void growIfFull() {
+        if (!slots) allocate(1);
+        else if ((elements + 1) * 8 > capacity() * 7) rehashTo(groups() * 2);
+        else if (staleOverflow && erasedSinceRehash * 8 >= capacity()) rehashTo(groups());
+    }
+
+    void eraseAt(size_t i) {
+        // Undo the overflow counts that this element's insertion added along its probe path
+        uint64_t h = mix(KeyOf()(slots[i]));
+        size_t target = i / GroupSize;
+        size_t g = startGroup(h);
+        for (size_t step = 1; g != target; ++step) {
+            if (overflow[g] != OverflowSaturated) --overflow[g];
+            else staleOverflow = true;
+            g = (g + step) & groupMask;
+        }
+        slots[i].~Element();
+        ctrl[i] = Empty;
+        --elements;
+        ++erasedSinceRehash;
+    }
+
+public:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class SwissBase;
+        using TablePtr = typename conditional<Const, const SwissBase*, SwissBase*>::type;
+        TablePtr table;
+        size_t index; // table->capacity() for end()
+
+        // Moves to the first full slot at or after index
+        void settle() {
+            size_t cap = table->capacity();
+            while (index < cap) {
+                size_t g = index / SwissBase::GroupSize;
+                unsigned full = table->matchFull(g) >> (index % SwissBase::GroupSize);
+                if (full) {
+                    index += __builtin_ctz(full);
+                    return;
+                }
+                index = (g + 1) * SwissBase::GroupSize;
+            }
+            index = cap;
+        }
+
+        Iterator(TablePtr t, size_t i) : table(t), index(i) { settle(); }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Element;
+        using difference_type = ptrdiff_t;
+        using pointer = typename conditional<Const, const Element*, Element*>::type;
+        using reference = typename conditional<Const, const Element&, Element&>::type;
+
+        Iterator() : table(nullptr), index(0) {}
+        operator Iterator<true>() const { return Iterator<true>(table, index); }
+
+        reference operator*() const { return table->slots[index]; }
+        pointer operator->() const { return &table->slots[index]; }
+
+        Iterator& operator++() {
+            ++index;
+            settle();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit SwissBase(const Hash& h = Hash(), const Equal& e = Equal())
+        : ctrl(nullptr), overflow(nullptr), slots(nullptr), groupMask(0), elements(0),
+          erasedSinceRehash(0), staleOverflow(false), hasher(h), equal(e) {}
+
+    ~SwissBase() {
+        release();
+    }
+
+    SwissBase(const SwissBase& other) : SwissBase(other.hasher, other.equal) {
+        reserve(other.size());
+        for (const Element& e : other) insert(e);
+    }
+
+    SwissBase& operator=(const SwissBase& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            for (const Element& e : other) insert(e);
+        }
+        return *this;
+    }
+
+    pair<iterator, bool> insert(const Element& element) {
+        size_t i = findIndex(KeyOf()(element));
+        if (i != SIZE_MAX) return {iterator(this, i), false};
+        growIfFull();
+        i = placeNew(mix(KeyOf()(element)), Element(element));
+        return {iterator(this, i), true};
+    }
+
+    iterator find(const Key& key) {
+        size_t i = findIndex(key);
+        return i == SIZE_MAX ? end() : iterator(this, i);
+    }
+
+    const_iterator find(const Key& key) const {
+        size_t i = findIndex(key);
+        return i == SIZE_MAX ? end() : const_iterator(this, i);
+    }
+
+    size_t count(const Key& key) const { return findIndex(key) != SIZE_MAX ? 1 : 0; }
+
+    size_t erase(const Key& key) {
+        size_t i = findIndex(key);
+        if (i == SIZE_MAX) return 0;
+        eraseAt(i);
+        return 1;
+    }
+
+    // Erasing never moves other elements, so the returned iterator is simply the next full slot
+    iterator erase(const_iterator it) {
+        size_t i = it.index;
+        eraseAt(i);
+        return iterator(this, i + 1);
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity()); }
+
+    size_t size() const { return elements; }
+    bool empty() const { return elements == 0; }
+    size_t bucket_count() const { return capacity(); }
+    float load_factor() const { return slots ? float(elements) / capacity() : 0.0f; }
+
+    // Keeps the allocation, like unordered_map::clear keeps its buckets
+    void clear() {
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] != Empty) slots[i].~Element();
+        }
+        if (slots) {
+            memset(ctrl, Empty, capacity());
+            memset(overflow, 0, groups());
+        }
+        elements = 0;
+        erasedSinceRehash = 0;
+        staleOverflow = false;
+    }
+
+    // Sizes the table so that n elements fit without rehashing
+    void reserve(size_t n) {
+        size_t groupCount = 1;
+        while (groupCount * GroupSize * 7 < n * 8) groupCount *= 2;
+        if (groupCount > groups()) {
+            if (slots) rehashTo(groupCount);
+            else allocate(groupCount);
+        }
+    }
+
+    // Bytes held by the table: slots plus two metadata arrays
+    size_t memory_bytes() const { return capacity() * (sizeof(Element) + 1) + groups(); }
+};
+
+struct IdentityKey {
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+};
+
+struct FirstKey {
+    template <typename P>
+    const typename P::first_type& operator()(const P& p) const { return p.first; }
+};
+
+template <typename Key, typename Hash = hash<Key>, typename Equal = equal_to<Key>>
+class SwissSet : public SwissBase<Key, Key, IdentityKey, Hash, Equal> {
+    using Base = SwissBase<Key, Key, IdentityKey, Hash, Equal>;
+
+public:
+    using Base::Base;
+    using Base::insert;
+
+    pair<typename Base::iterator, bool> emplace(const Key& key) { return Base::insert(key); }
+};
+
+// Elements are pair<Key, Value>; never modify it->first through an iterator
+template <typename Key, typename Value, typename Hash = hash<Key>, typename Equal = equal_to<Key>>
+class SwissMap : public SwissBase<pair<Key, Value>, Key, FirstKey, Hash, Equal> {
+    using Base = SwissBase<pair<Key, Value>, Key, FirstKey, Hash, Equal>;
+
+public:
+    using Base::Base;
+    using Base::insert;
+
+    pair<typename Base::iterator, bool> emplace(const Key& key, const Value& value) {
+        return Base::insert(pair<Key, Value>(key, value));
+    }
+
+    Value& operator[](const Key& key) {
+        size_t i = this->findIndex(key);
+        if (i == SIZE_MAX) {
+            this->growIfFull();
+            i = this->placeNew(this->mix(key), pair<Key, Value>(key, Value()));
+        }
+        return this->slots[i].second;
+    }
+};
+
+// Same steps as unorderedSetUsage() in example.cpp
+void swissSetUsage() {
+    SwissSet<int> us;
+    us.insert(10);
+    us.insert(20);
+    us.insert(10); // Duplicate (will be ignored)
+    us.insert(30);
+
+    cout << "Swiss Set after insertions: ";
+    for (const auto& n : us) cout << n << " "; // Output: 10 20 30 (order may vary)
+    cout << endl;
+    cout << "Count of 10: " << us.count(10) << endl; // Output: 1
+    cout << "Count of 40: " << us.count(40) << endl; // Output: 0
+
+    us.erase(20);
+    cout << "Swiss Set after removing 20: ";
+    for (const auto& n : us) cout << n << " "; // Output: 10 30 (order may vary)
+    cout << endl;
+    cout << "Size of swiss set: " << us.size() << endl; // Output: 2
+    us.clear();
+    cout << "Swiss Set size after clear: " << us.size() << endl; // Output: 0
+}
+
+// Same steps as unorderedMapUsage() in example.cpp
+void swissMapUsage() {
+    SwissMap<string, int> um;
+    um.insert({"Alice", 25});
+    um.insert({"Bob", 30});
+    um.insert({"Alice", 35}); // Duplicate key (ignored, as with unordered_map::insert)
+    um.insert({"Charlie", 40});
+
+    cout << "Swiss Map after insertions:\n";
+    for (const auto& p : um) cout << p.first << ": " << p.second << endl; // Output: All pairs, order may vary
+    cout << "Count of Alice: " << um.count("Alice") << endl; // Output: 1
+
+    um.erase("Bob");
+    cout << "Swiss Map after removing Bob:\n";
+    for (auto it = um.begin(); it != um.end(); ++it) cout << it->first << ": " << it->second << endl; // Output: Remaining pairs
+
+    cout << "Size of swiss map: " << um.size() << endl; // Output: 2
+    um.clear();
+    cout << "Swiss Map size after clear: " << um.size() << endl; // Output: 0
+}
+
+// Randomized comparison against unordered_map, with enough churn to exercise the overflow counts
+bool swissSelfCheck() {
+    mt19937 rng(13);
+    SwissMap<int, int> swiss;
+    unordered_map<int, int> reference;
+    for (int round = 0; round < 300000; ++round) {
+        int key = static_cast<int>(rng() % 5000);
+        switch (rng() % 3) {
+            case 0:
+                swiss[key] = round;
+                reference[key] = round;
+                break;
+            case 1:
+                if (swiss.erase(key) != reference.erase(key)) return false;
+                break;
+            case 2: {
+                auto it = swiss.find(key);
+                auto expected = reference.find(key);
+                if ((it == swiss.end()) != (expected == reference.end())) return false;
+                if (it != swiss.end() && it->second != expected->second) return false;
+                break;
+            }
+        }
+    }
+    size_t seen = 0;
+    for (const auto& p : swiss) {
+        auto expected = reference.find(p.first);
+        if (expected == reference.end() || expected->second != p.second) return false;
+        ++seen;
+    }
+    if (seen != reference.size()) return false;
+    // Erase every odd key through iterators
+    for (auto it = swiss.begin(); it != swiss.end();) {
+        if (it->first % 2) {
+            reference.erase(it->first);
+            it = swiss.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& p : reference) {
+        if (swiss.count(p.first) != 1) return false;
+    }
+    return swiss.size() == reference.size();
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename StdTable, typename Swiss, typename Key>
+void benchmarkSets(const string& title, const vector<Key>& keys, const vector<Key>& misses) {
+    StdTable stdTable;
+    Swiss swiss;
+    long long sa = 0, sb = 0;
+    cout << "\n" << title << " (" << keys.size() << " keys, std / swiss):\n";
+    double a = timeMs([&]() { for (const auto& k : keys) stdTable.insert(k); });
+    double b = timeMs([&]() { for (const auto& k : keys) swiss.insert(k); });
+    cout << "  insert:        " << a << " / " << b << " ms\n";
+
+    auto lookups = [&](auto& table, const vector<Key>& probes, long long& sum) {
+        return timeMs([&]() { for (const auto& k : probes) sum += table.count(k); });
+    };
+    for (int hitPercent : {100, 50, 0}) {
+        vector<Key> probes;
+        mt19937 rng(hitPercent);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            probes.push_back(int(rng() % 100) < hitPercent ? keys[rng() % keys.size()] : misses[rng() % misses.size()]);
+        }
+        a = lookups(stdTable, probes, sa);
+        b = lookups(swiss, probes, sb);
+        cout << "  " << hitPercent << "% hits:" << string(hitPercent == 100 ? 5 : hitPercent == 50 ? 6 : 7, ' ') << a << " / " << b << " ms\n";
+    }
+
+    // Churn: erase and reinsert every key; without tombstones the table stays as fast as before
+    a = timeMs([&]() {
+        for (const auto& k : keys) {
+            stdTable.erase(k);
+            stdTable.insert(k);
+        }
+    });
+    b = timeMs([&]() {
+        for (const auto& k : keys) {
+            swiss.erase(k);
+            swiss.insert(k);
+        }
+    });
+    cout << "  erase+insert:  " << a << " / " << b << " ms (swiss load factor " << swiss.load_factor() << ")\n";
+    cout << "  Results agree: " << (sa == sb && stdTable.size() == swiss.size() ? "Yes" : "No") << endl;
+}
+
+void swissBenchmark() {
+    const size_t n = 1000000;
+    mt19937 rng(29);
+    vector<int> ints(n), intMisses(n);
+    for (size_t i = 0; i < n; ++i) {
+        ints[i] = static_cast<int>(rng() & 0x7FFFFFFF);
+        intMisses[i] = -1 - static_cast<int>(rng() & 0x7FFFFFFF); // Negative: never inserted
+    }
+    benchmarkSets<unordered_set<int>, SwissSet<int>>("unordered_set<int> vs SwissSet<int>", ints, intMisses);
+
+    vector<pair<string, int>> items, itemMisses;
+    for (size_t i = 0; i < n; ++i) {
+        items.push_back({"customer-" + to_string(rng()), static_cast<int>(i)});
+        itemMisses.push_back({"visitor-" + to_string(rng()), 0});
+    }
+    unordered_map<string, int> stdMap;
+    SwissMap<string, int> swissMap;
+    vector<string> hitKeys, missKeys;
+    for (const auto& p : items) hitKeys.push_back(p.first);
+    for (const auto& p : itemMisses) missKeys.push_back(p.first);
+    long long sa = 0, sb = 0;
+    cout << "\nunordered_map<string,int> vs SwissMap<string,int> (" << n << " keys, std / swiss):\n";
+    double a = timeMs([&]() { for (const auto& p : items) stdMap.insert(p); });
+    double b = timeMs([&]() { for (const auto& p : items) swissMap.insert(p); });
+    cout << "  insert:        " << a << " / " << b << " ms\n";
+    for (int hitPercent : {100, 50, 0}) {
+        vector<string> probes;
+        for (size_t i = 0; i < n; ++i) probes.push_back(int(rng() % 100) < hitPercent ? hitKeys[rng() % n] : missKeys[rng() % n]);
+        a = timeMs([&]() { for (const auto& k : probes) sa += stdMap.count(k); });
+        b = timeMs([&]() { for (const auto& k : probes) sb += swissMap.count(k); });
+        cout << "  " << hitPercent << "% hits:" << string(hitPercent == 100 ? 5 : hitPercent == 50 ? 6 : 7, ' ') << a << " / " << b << " ms\n";
+    }
+    cout << "  Results agree: " << (sa == sb && stdMap.size() == swissMap.size() ? "Yes" : "No") << endl;
+}
+
+int main() {
+    cout << "Swiss Set Usage:\n";
+    swissSetUsage();
+    cout << "\nSwiss Map Usage:\n";
+    swissMapUsage();
+    cout << "\nSelf-check against unordered_map: " << (swissSelfCheck() ? "passed" : "FAILED") << endl;
+    swissBenchmark();
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+
+/**
+ * Heterogeneous (string_view) Lookup in String-Keyed Maps:
+ *
+ * 1. **Problem**:
+ *    - map<string, int>::count("Alice") converts "Alice" to a temporary std::string before it can
+ *      compare. Keys longer than the small-string buffer (15 chars in libstdc++) cost a malloc
+ *      and a free on every lookup, and request parsers usually hold string_views, not strings.
+ *
+ * 2. **Transparent function objects**:
+ *    - StringLess, StringHash and StringEqual take string_view and declare `is_transparent`, which
+ *      tells the containers to pass the caller's key type straight through instead of converting.
+ *    - Aliases: StringSet, StringMap<V>, StringMultimap<V> (tree based) and StringUnorderedSet,
+ *      StringUnorderedMap<V> (hash based). They are ordinary std containers; insert and iterate as usual.
+ *
+ * 3. **Lookup helpers**: findKey, countKey, eraseKey take a string_view and work on every alias.
+ *    - Tree containers have transparent find/count/equal_range since C++14, but erase(key) only
+ *      becomes transparent in C++23, so eraseKey erases the equal_range instead.
+ *    - Hash containers get transparent lookup in C++20. Before that, the helpers copy the view
+ *      into a reused thread_local string: its buffer is allocated once and then recycled, so
+ *      lookups stop allocating after the longest key has been seen.
+ *    - Passing string_view (not const char*) also avoids a strlen per comparison.
+ */
+
+struct StringLess {
+    using is_transparent = void;
+    bool operator()(string_view a, string_view b) const { return a < b; }
+};
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(string_view s) const { return hash<string_view>()(s); }
+};
+
+struct StringEqual {
+    using is_transparent = void;
+    bool operator()(string_view a, string_view b) const { return a == b; }
+};
+
+using StringSet = set<string, StringLess>;
+template <typename Value>
+using StringMap = map<string, Value, StringLess>;
+template <typename Value>
+using StringMultimap = multimap<string, Value, StringLess>;
+using StringUnorderedSet = unordered_set<string, StringHash, StringEqual>;
+template <typename Value>
+using StringUnorderedMap = unordered_map<string, Value, StringHash, StringEqual>;
+
+template <typename Container, typename = void>
+struct IsHashed : false_type {};
+template <typename Container>
+struct IsHashed<Container, void_t<typename Container::hasher>> : true_type {};
+
+// The key to hand to Container's lookup functions for a string_view
+template <typename Container>
+decltype(auto) lookupKey(string_view key) {
+#if defined(__cpp_lib_generic_unordered_lookup) && __cpp_lib_generic_unordered_lookup >= 201811L
+    return key;
+#else
+    if constexpr (IsHashed<Container>::value) {
+        thread_local string buffer; // Reused: no allocation once it is long enough
+        buffer.assign(key.data(), key.size());
+        return static_cast<const string&>(buffer);
+    } else {
+        return key;
+    }
+#endif
+}
+
+template <typename Container>
+auto findKey(Container& c, string_view key) {
+    return c.find(lookupKey<Container>(key));
+}
+
+template <typename Container>
+size_t countKey(const Container& c, string_view key) {
+    return c.count(lookupKey<Container>(key));
+}
+
+// Removes every element with this key, like erase(key); returns how many were removed
+template <typename Container>
+size_t eraseKey(Container& c, string_view key) {
+    auto range = c.equal_range(lookupKey<Container>(key));
+    size_t removed = distance(range.first, range.second);
+    c.erase(range.first, range.second);
+    return removed;
+}
+
+// Same steps as mapUsage() / multimapUsage() / unorderedMapUsage(), looking keys up by string_view
+void transparentLookupUsage() {
+    StringMap<int> m;
+    m["Alice"] = 25;
+    m.insert({"Bob", 30});
+    string_view request = "GET /users/Alice";
+    string_view name = request.substr(11); // "Alice", no copy
+    cout << "Count of " << name << ": " << m.count(name) << endl; // Output: 1
+    cout << "Bob's age: " << m.find("Bob")->second << endl; // Output: 30
+    cout << "Erased from map: " << eraseKey(m, name) << endl; // Output: 1
+
+    StringMultimap<int> mm;
+    mm.insert({"Alice", 25});
+    mm.insert({"Bob", 30});
+    mm.insert({"Alice", 35});
+    cout << "Count of Alice in multimap: " << mm.count(name) << endl; // Output: 2
+    cout << "Erased from multimap: " << eraseKey(mm, name) << endl; // Output: 2
+
+    StringUnorderedMap<int> um;
+    um.insert({"Alice", 25});
+    um.insert({"Charlie", 40});
+    cout << "Count of Charlie in unordered map: " << countKey(um, "Charlie") << endl; // Output: 1
+    cout << "Alice's age: " << findKey(um, name)->second << endl; // Output: 25
+    cout << "Erased from unordered map: " << eraseKey(um, name) << endl; // Output: 1
+    cout << "Size of unordered map: " << um.size() << endl; // Output: 1
+}
+
+// Counts every call to the global operator new
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+template <typename F>
+void measure(const string& label, size_t lookups, F&& f) {
+    size_t before = allocationCount;
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    double perMillion = double(allocationCount - before) * 1e6 / lookups;
+    cout << "  " << label << chrono::duration<double, milli>(end - start).count() << " ms, " << perMillion
+         << " allocations per million lookups\n";
+}
+
+void transparentLookupBenchmark() {
+    const size_t n = 200000;
+    const size_t lookups = 1000000;
+    mt19937 rng(31);
+    vector<string> keys;
+    for (size_t i = 0; i < n; ++i) keys.push_back("account-" + to_string(1000000000 + rng() % 1000000000) + "-eu"); // 21 chars
+
+    // Lookups arrive as views into one request buffer, as a parser would produce them
+    string buffer;
+    vector<pair<size_t, size_t>> spans;
+    for (size_t i = 0; i < lookups; ++i) {
+        const string& k = keys[rng() % n];
+        spans.push_back({buffer.size(), k.size()});
+        buffer += k;
+    }
+    vector<string_view> views;
+    for (auto& s : spans) views.push_back(string_view(buffer).substr(s.first, s.second));
+
+    map<string, int> plainMap;
+    StringMap<int> transparentMap;
+    unordered_map<string, int> plainHash;
+    StringUnorderedMap<int> transparentHash;
+    for (size_t i = 0; i < n; ++i) {
+        plainMap.emplace(keys[i], static_cast<int>(i));
+        transparentMap.emplace(keys[i], static_cast<int>(i));
+        plainHash.emplace(keys[i], static_cast<int>(i));
+        transparentHash.emplace(keys[i], static_cast<int>(i));
+    }
+
+    long long sa = 0, sb = 0;
+    cout << "\n" << lookups << " lookups of 21-char keys given as string_view:\n";
+    measure("map<string,int>::count(string(view)):      ", lookups, [&]() { for (auto v : views) sa += plainMap.count(string(v)); });
+    measure("StringMap<int>::count(view):               ", lookups, [&]() { for (auto v : views) sb += transparentMap.count(v); });
+    measure("unordered_map<string,int>::count(string):  ", lookups, [&]() { for (auto v : views) sa += plainHash.count(string(v)); });
+    measure("countKey(StringUnorderedMap<int>, view):   ", lookups, [&]() { for (auto v : views) sb += countKey(transparentHash, v); });
+
+    // Erasing by view: a missing key is the common case in a cache invalidation path
+    measure("map<string,int>::erase(string(view)):      ", lookups, [&]() { for (auto v : views) sa += plainMap.erase(string(v)); });
+    measure("eraseKey(StringMap<int>, view):            ", lookups, [&]() { for (auto v : views) sb += eraseKey(transparentMap, v); });
+    cout << "  Results agree: " << (sa == sb ? "Yes" : "No") << endl;
+}
+
+int main() {
+    transparentLookupUsage();
+    transparentLookupBenchmark();
+    return 0;
+}